@@ -74,8 +74,22 @@ typedef struct AutoPat
     int		    buflocal_nr;	// !=0 for buffer-local AutoPat
     char	    allow_dirs;		// Pattern may match whole path
     char	    last;		// last pattern for apply_autocmds()
+    char	    kind;		// AP_ value
+    int		    litoff;		// offset of the literal name in "pat"
 } AutoPat;
 
+/*
+ * Most patterns are "*", "*.ext" or a plain name.  These can be matched
+ * without the regexp, which is much faster for events like CursorMoved that
+ * are triggered often.  The regexp is still used when the file name contains
+ * non-ASCII characters, because of case folding and composing characters.
+ */
+#define AP_REGEXP	0	// only matched with the regexp
+#define AP_ANY		1	// "*": matches any name
+#define AP_TAIL		2	// "name" or "*name": (end of) the tail
+#define AP_PATH		3	// "dir/name" or "*/name": (end of) the full or
+				// short name
+
 static struct event_name
 {
     char	*name;	// event name
@@ -338,6 +352,110 @@ show_autocmd(AutoPat *ap, event_T event)
     }
 }
 
+/*
+ * Set "ap->kind" and "ap->litoff" for the pattern "ap->pat".  Must be called
+ * after "ap->allow_dirs" was set.
+ */
+    static void
+au_set_pat_kind(AutoPat *ap)
+{
+    char_u  *p;
+
+    for (p = ap->pat; *p == '*'; ++p)
+	;
+    ap->litoff = (int)(p - ap->pat);
+    if (*p == NUL)
+    {
+	ap->kind = AP_ANY;
+	return;
+    }
+    for ( ; *p != NUL; ++p)
+    {
+	// Anything that is special in a file pattern or a regexp requires
+	// the regexp.
+	if (*p >= 0x80 || vim_strchr((char_u *)"*?[]{}\\,~^$", *p) != NULL)
+	{
+	    ap->kind = AP_REGEXP;
+	    return;
+	}
+    }
+    ap->kind = ap->allow_dirs ? AP_PATH : AP_TAIL;
+}
+
+/*
+ * Return TRUE if "name" only contains ASCII characters.
+ */
+    static int
+au_ascii_name(char_u *name)
+{
+    char_u  *p;
+
+    for (p = name; *p != NUL; ++p)
+	if (*p >= 0x80)
+	    return FALSE;
+    return TRUE;
+}
+
+/*
+ * Return TRUE if the literal name of "ap" matches "name", or the end of
+ * "name" when the pattern starts with a star.
+ */
+    static int
+au_match_literal(AutoPat *ap, char_u *name)
+{
+    char_u  *lit = ap->pat + ap->litoff;
+    int	    litlen = ap->patlen - ap->litoff;
+    int	    len = (int)STRLEN(name);
+    int	    i;
+
+    if (ap->litoff == 0 ? len != litlen : len < litlen)
+	return FALSE;
+    name += len - litlen;
+#ifdef BACKSLASH_IN_FILENAME
+    // A '/' in the pattern also matches a backslash.
+    for (i = 0; i < litlen; ++i)
+	if (lit[i] == '/' ? name[i] != '/' && name[i] != '\\'
+		: p_fic ? TOLOWER_ASC(name[i]) != TOLOWER_ASC(lit[i])
+		: name[i] != lit[i])
+	    return FALSE;
+#else
+    if (!p_fic)
+	return STRNCMP(name, lit, litlen) == 0;
+    for (i = 0; i < litlen; ++i)
+	if (TOLOWER_ASC(name[i]) != TOLOWER_ASC(lit[i]))
+	    return FALSE;
+#endif
+    return TRUE;
+}
+
+/*
+ * Return TRUE if the pattern of "ap" matches a file: "fname" is the full
+ * name, "sfname" the short name or NULL and "tail" the tail of "fname".
+ * Gives the same result as match_file_pat(), but avoids using the regexp
+ * when possible.
+ */
+    static int
+au_match_pat(AutoPat *ap, char_u *fname, char_u *sfname, char_u *tail)
+{
+    switch (ap->kind)
+    {
+	case AP_ANY:
+	    return TRUE;
+	case AP_TAIL:
+	    if (au_ascii_name(tail))
+		return au_match_literal(ap, tail);
+	    break;
+	case AP_PATH:
+	    if (au_ascii_name(fname)
+				&& (sfname == NULL || au_ascii_name(sfname)))
+		return au_match_literal(ap, fname)
+			  || (sfname != NULL && au_match_literal(ap, sfname));
+	    break;
+    }
+    return match_file_pat(NULL, &ap->reg_prog, fname, sfname, tail,
+							       ap->allow_dirs);
+}
+
 /*
  * Mark an autocommand pattern for deletion.
  */
@@ -1208,6 +1326,7 @@ do_autocmd_event(
 		{
 		    ap->buflocal_nr = buflocal_nr;
 		    ap->reg_prog = NULL;
+		    ap->kind = AP_REGEXP;
 		}
 		else
 		{
@@ -1225,6 +1344,7 @@ do_autocmd_event(
 			vim_free(ap);
 			return FAIL;
 		    }
+		    au_set_pat_kind(ap);
 		}
 		ap->cmds = NULL;
 		*prev_ap = ap;
@@ -2277,8 +2397,7 @@ auto_next_pat(
 	{
 	    // execution-condition
 	    if (ap->buflocal_nr == 0
-		    ? (match_file_pat(NULL, &ap->reg_prog, apc->fname,
-				      apc->sfname, apc->tail, ap->allow_dirs))
+		    ? au_match_pat(ap, apc->fname, apc->sfname, apc->tail)
 		    : ap->buflocal_nr == apc->arg_bufnr)
 	    {
 		name = event_nr2name(apc->event);
@@ -2384,11 +2503,29 @@ getnextac(int c UNUSED, void *cookie, int indent UNUSED, int do_concat UNUSED)
  */
     int
 has_autocmd(event_T event, char_u *sfname, buf_T *buf)
+{
+    return has_autocmd_skip_group(event, sfname, buf, NULL);
+}
+
+/*
+ * Like has_autocmd(), but autocommands in the group named "skip_group" are
+ * not counted.  When "skip_group" is NULL all autocommands are counted.
+ */
+    int
+has_autocmd_skip_group(
+    event_T	event,
+    char_u	*sfname,
+    buf_T	*buf,
+    char_u	*skip_group)
 {
     AutoPat	*ap;
     char_u	*fname;
     char_u	*tail = gettail(sfname);
     int		retval = FALSE;
+    int		skip = AUGROUP_ERROR;
+
+    if (skip_group != NULL)
+	skip = au_find_group(skip_group);
 
     fname = FullName_save(sfname, FALSE);
     if (fname == NULL)
@@ -2406,10 +2543,9 @@ has_autocmd(event_T event, char_u *sfname, buf_T *buf)
 #endif
 
     FOR_ALL_AUTOCMD_PATTERNS(event, ap)
-	if (ap->pat != NULL && ap->cmds != NULL
+	if (ap->pat != NULL && ap->cmds != NULL && ap->group != skip
 	      && (ap->buflocal_nr == 0
-		? match_file_pat(NULL, &ap->reg_prog,
-					  fname, sfname, tail, ap->allow_dirs)
+		? au_match_pat(ap, fname, sfname, tail)
 		: buf != NULL && ap->buflocal_nr == buf->b_fnum
 	   ))
 	{
@@ -102,8 +102,8 @@ read_buffer(
     if (retval == OK)
     {
 	// Delete the binary lines.
-	while (--line_count >= 0)
-	    ml_delete((linenr_T)1, FALSE);
+	if (line_count > 0)
+	    ml_delete_lines((linenr_T)1, (long)line_count, FALSE);
     }
     else
     {
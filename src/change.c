@@ -2312,18 +2312,14 @@ del_lines(long nlines,	int undo)
     if (undo && u_savedel(first, nlines) == FAIL)
 	return;
 
-    for (n = 0; n < nlines; )
-    {
-	if (curbuf->b_ml.ml_flags & ML_EMPTY)	    // nothing to delete
-	    break;
-
-	ml_delete(first, TRUE);
-	++n;
-
-	// If we delete the last line in the file, stop
-	if (first > curbuf->b_ml.ml_line_count)
-	    break;
-    }
+    // Stop at the last line in the file.
+    n = curbuf->b_ml.ml_line_count - first + 1;
+    if (n > nlines)
+	n = nlines;
+    if ((curbuf->b_ml.ml_flags & ML_EMPTY) || n <= 0)	// nothing to delete
+	n = 0;
+    else
+	ml_delete_lines(first, n, TRUE);
 
     // Correct the cursor position before calling deleted_lines_mark(), it may
     // trigger a callback to display the cursor.
@@ -52,6 +52,9 @@
 # ifdef HAVE_LIBGEN_H
 #  include <libgen.h>
 # endif
+# ifdef USE_EPOLL
+#  include <sys/epoll.h>
+# endif
 # define SOCK_ERRNO
 # define sock_write(sd, buf, len) write(sd, buf, len)
 # define sock_read(sd, buf, len) read(sd, buf, len)
@@ -327,6 +330,9 @@ add_channel(void)
     for (part = PART_SOCK; part < PART_COUNT; ++part)
     {
 	channel->ch_part[part].ch_fd = INVALID_FD;
+#ifdef USE_EPOLL
+	channel->ch_part[part].ch_epoll_channel = channel;
+#endif
 #ifdef FEAT_GUI_X11
 	channel->ch_part[part].ch_inputHandler = (XtInputId)NULL;
 #endif
@@ -734,6 +740,120 @@ channel_gui_unregister(channel_T *channel)
 
 #endif  // FEAT_GUI
 
+#ifdef USE_EPOLL
+// Values for ch_epoll_state.
+# define EPOLL_NONE	0   // not registered
+# define EPOLL_WATCH	1   // fd is in the epoll set
+# define EPOLL_POLL	2   // fd is added to every select() or poll()
+
+// Maximum number of events handled by one epoll_wait() call, the others are
+// reported by the next call.
+# define EPOLL_MAX_EVENTS 64
+
+// The epoll instance that all readable channel fds are registered with.
+static int channel_epoll_fd = -1;
+
+// Number of channel parts that use EPOLL_POLL.
+static int channel_epoll_poll_count = 0;
+
+/*
+ * Register the fd of "part" of "channel" for reading.  The fd stays in the
+ * epoll set until the part is closed.  A keep-open channel or a fd that
+ * epoll does not support is polled like before.
+ */
+    static void
+channel_epoll_register_one(channel_T *channel, ch_part_T part)
+{
+    chanpart_T		*ch_part = &channel->ch_part[part];
+    ch_part_T		other;
+    struct epoll_event	ev;
+
+    if (ch_part->ch_fd == INVALID_FD || ch_part->ch_epoll_state != EPOLL_NONE)
+	return;
+
+    // When parts share a fd it only needs to be read once.
+    for (other = PART_SOCK; other < PART_IN; ++other)
+	if (other != part
+		&& channel->ch_part[other].ch_fd == ch_part->ch_fd
+		&& channel->ch_part[other].ch_epoll_state != EPOLL_NONE)
+	    return;
+
+    if (!channel->ch_keep_open)
+    {
+	if (channel_epoll_fd < 0)
+	    channel_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (channel_epoll_fd >= 0)
+	{
+	    CLEAR_FIELD(ev);
+	    ev.events = EPOLLIN;
+	    ev.data.ptr = ch_part;
+	    if (epoll_ctl(channel_epoll_fd, EPOLL_CTL_ADD, (int)ch_part->ch_fd,
+								     &ev) == 0)
+	    {
+		ch_log(channel, "Registered part %s with fd %d for epoll",
+					     part_names[part], ch_part->ch_fd);
+		ch_part->ch_epoll_state = EPOLL_WATCH;
+		return;
+	    }
+	}
+    }
+    ch_part->ch_epoll_state = EPOLL_POLL;
+    ++channel_epoll_poll_count;
+}
+
+/*
+ * Remove the fd of "part" of "channel" from the epoll set.  Must be called
+ * before the fd is closed.  When another part uses the same fd it is
+ * registered for that part instead.
+ */
+    static void
+channel_epoll_unregister_one(channel_T *channel, ch_part_T part)
+{
+    chanpart_T	*ch_part = &channel->ch_part[part];
+    ch_part_T	other;
+
+    if (ch_part->ch_epoll_state == EPOLL_NONE)
+	return;
+    if (ch_part->ch_epoll_state == EPOLL_WATCH)
+	epoll_ctl(channel_epoll_fd, EPOLL_CTL_DEL, (int)ch_part->ch_fd, NULL);
+    else
+	--channel_epoll_poll_count;
+    ch_part->ch_epoll_state = EPOLL_NONE;
+
+    for (other = PART_SOCK; other < PART_IN; ++other)
+	if (other != part && channel->ch_part[other].ch_fd == ch_part->ch_fd)
+	{
+	    channel_epoll_register_one(channel, other);
+	    break;
+	}
+}
+
+/*
+ * Read from the channel parts that epoll reports to be readable.
+ * Only called when select() or poll() found "channel_epoll_fd" readable, thus
+ * this does not block.
+ */
+    static void
+channel_epoll_check(void)
+{
+    struct epoll_event	events[EPOLL_MAX_EVENTS];
+    int			n;
+    int			i;
+
+    n = epoll_wait(channel_epoll_fd, events, EPOLL_MAX_EVENTS, 0);
+    for (i = 0; i < n; ++i)
+    {
+	chanpart_T  *ch_part = events[i].data.ptr;
+	channel_T   *channel = ch_part->ch_epoll_channel;
+
+	// Reading an earlier part may have closed this one.
+	if (ch_part->ch_epoll_state == EPOLL_WATCH)
+	    channel_read(channel, (ch_part_T)(ch_part - channel->ch_part),
+							 "channel_epoll_check");
+    }
+}
+#endif  // USE_EPOLL
+
 static char *e_cannot_connect = N_("E902: Cannot connect to port");
 
 /*
@@ -1112,6 +1232,9 @@ channel_open(
 #ifdef FEAT_GUI
     channel_gui_register_one(channel, PART_SOCK);
 #endif
+#ifdef USE_EPOLL
+    channel_epoll_register_one(channel, PART_SOCK);
+#endif
 
     return channel;
 }
@@ -1426,6 +1549,9 @@ ch_close_part(channel_T *channel, ch_part_T part)
 
     if (*fd != INVALID_FD)
     {
+#ifdef USE_EPOLL
+	channel_epoll_unregister_one(channel, part);
+#endif
 	if (part == PART_SOCK)
 	    sock_close(*fd);
 	else
@@ -1474,6 +1600,9 @@ channel_set_pipes(channel_T *channel, sock_T in, sock_T out, sock_T err)
 	channel->ch_to_be_closed |= (1U << PART_OUT);
 # if defined(FEAT_GUI)
 	channel_gui_register_one(channel, PART_OUT);
+# endif
+# ifdef USE_EPOLL
+	channel_epoll_register_one(channel, PART_OUT);
 # endif
     }
     if (err != INVALID_FD)
@@ -1492,6 +1621,9 @@ channel_set_pipes(channel_T *channel, sock_T in, sock_T out, sock_T err)
 	    channel->ch_to_be_closed |= (1U << PART_ERR);
 # if defined(FEAT_GUI)
 	    channel_gui_register_one(channel, PART_ERR);
+# endif
+# ifdef USE_EPOLL
+	    channel_epoll_register_one(channel, PART_ERR);
 # endif
 	}
     }
@@ -1883,6 +2015,7 @@ channel_get(channel_T *channel, ch_part_T part, int *outlen)
 	return NULL;
     if (outlen != NULL)
 	*outlen += node->rq_buflen;
+    CLEAR_FIELD(channel->ch_part[part].ch_json_scan);
     // dispose of the node but keep the buffer
     p = node->rq_buffer;
     head->rq_next = node->rq_next;
@@ -1980,6 +2113,7 @@ channel_consume(channel_T *channel, ch_part_T part, int len)
     mch_memmove(buf, buf + len, node->rq_buflen - len);
     node->rq_buflen -= len;
     node->rq_buffer[node->rq_buflen] = NUL;
+    CLEAR_FIELD(channel->ch_part[part].ch_json_scan);
 }
 
 /*
@@ -2089,6 +2223,7 @@ channel_save(channel_T *channel, ch_part_T part, char_u *buf, int len,
     if (prepend)
     {
 	// prepend node to the head of the queue
+	CLEAR_FIELD(channel->ch_part[part].ch_json_scan);
 	node->rq_next = head->rq_next;
 	node->rq_prev = NULL;
 	if (head->rq_next == NULL)
@@ -2121,6 +2256,8 @@ channel_save(channel_T *channel, ch_part_T part, char_u *buf, int len,
 
 /*
  * Try to fill the buffer of "reader".
+ * Takes all the text that was received, adding one buffer at a time would
+ * copy a long message many times.
  * Returns FALSE when nothing was added.
  */
     static int
@@ -2128,36 +2265,120 @@ channel_fill(js_read_T *reader)
 {
     channel_T	*channel = (channel_T *)reader->js_cookie;
     ch_part_T	part = reader->js_cookie_arg;
-    char_u	*next = channel_get(channel, part, NULL);
+    readq_T	*node;
     int		keeplen;
-    int		addlen;
+    long_u	addlen = 0;
+    char_u	*next;
     char_u	*p;
+    char_u	*buf;
 
-    if (next == NULL)
+    if (channel_peek(channel, part) == NULL)
 	return FALSE;
 
+    for (node = channel->ch_part[part].ch_head.rq_next; node != NULL;
+							 node = node->rq_next)
+	addlen += node->rq_buflen;
     keeplen = reader->js_end - reader->js_buf;
-    if (keeplen > 0)
+    next = alloc(keeplen + addlen + 1);
+    if (next == NULL)
+	return FALSE;
+
+    // Prepend unused text.
+    mch_memmove(next, reader->js_buf, keeplen);
+    p = next + keeplen;
+    while ((buf = channel_get(channel, part, NULL)) != NULL)
     {
-	// Prepend unused text.
-	addlen = (int)STRLEN(next);
-	p = alloc(keeplen + addlen + 1);
-	if (p == NULL)
-	{
-	    vim_free(next);
-	    return FALSE;
-	}
-	mch_memmove(p, reader->js_buf, keeplen);
-	mch_memmove(p + keeplen, next, addlen + 1);
-	vim_free(next);
-	next = p;
+	addlen = STRLEN(buf);
+	mch_memmove(p, buf, addlen);
+	p += addlen;
+	vim_free(buf);
     }
+    *p = NUL;
 
     vim_free(reader->js_buf);
     reader->js_buf = next;
     return TRUE;
 }
 
+/*
+ * Check if the JSON message in the read queue of "channel"/"part" is
+ * complete, continuing where the previous check stopped.
+ * Sets "buflen" to the number of bytes in the queue.
+ * Returns OK, MAYBE or FAIL like json_scan().
+ */
+    static int
+channel_scan_json(channel_T *channel, ch_part_T part, size_t *buflen)
+{
+    chanpart_T	*chanpart = &channel->ch_part[part];
+    json_scan_T	*js = &chanpart->ch_json_scan;
+    int		options = chanpart->ch_mode == MODE_JS ? JSON_JS : 0;
+    readq_T	*node;
+    long_u	start = 0;
+
+    for (node = chanpart->ch_head.rq_next; node != NULL; node = node->rq_next)
+    {
+	if (start + node->rq_buflen > js->jsc_used)
+	    json_scan(js, node->rq_buffer + (js->jsc_used - start),
+			       start + node->rq_buflen - js->jsc_used, options);
+	start += node->rq_buflen;
+    }
+    *buflen = start;
+    return json_scan(js, (char_u *)"", 0, options);
+}
+
+/*
+ * Called when the message of "chanpart" is incomplete, "buflen" bytes were
+ * received.  When more was received since last time set a deadline for the
+ * rest to arrive.
+ * Returns TRUE when the deadline has passed.
+ */
+    static int
+channel_wait_incomplete(
+	channel_T   *channel,
+	chanpart_T  *chanpart,
+	size_t	    buflen)
+{
+    int timeout;
+
+    if (chanpart->ch_wait_len < buflen)
+    {
+	// First time encountering incomplete message or after receiving
+	// more (but still incomplete): set a deadline of 100 msec.
+	ch_log(channel,
+		"Incomplete message (%d bytes) - wait 100 msec for more",
+		(int)buflen);
+	chanpart->ch_wait_len = buflen;
+#ifdef MSWIN
+	chanpart->ch_deadline = GetTickCount() + 100L;
+#else
+	gettimeofday(&chanpart->ch_deadline, NULL);
+	chanpart->ch_deadline.tv_usec += 100 * 1000;
+	if (chanpart->ch_deadline.tv_usec > 1000 * 1000)
+	{
+	    chanpart->ch_deadline.tv_usec -= 1000 * 1000;
+	    ++chanpart->ch_deadline.tv_sec;
+	}
+#endif
+	return FALSE;
+    }
+
+#ifdef MSWIN
+    timeout = GetTickCount() > chanpart->ch_deadline;
+#else
+    {
+	struct timeval now_tv;
+
+	gettimeofday(&now_tv, NULL);
+	timeout = now_tv.tv_sec > chanpart->ch_deadline.tv_sec
+	      || (now_tv.tv_sec == chanpart->ch_deadline.tv_sec
+		   && now_tv.tv_usec > chanpart->ch_deadline.tv_usec);
+    }
+#endif
+    if (!timeout)
+	ch_log(channel, "still waiting on incomplete message");
+    return timeout;
+}
+
 /*
  * Use the read buffer of "channel"/"part" and parse a JSON message that is
  * complete.  The messages are added to the queue.
@@ -2171,12 +2392,21 @@ channel_parse_json(channel_T *channel, ch_part_T part)
     jsonq_T	*item;
     chanpart_T	*chanpart = &channel->ch_part[part];
     jsonq_T	*head = &chanpart->ch_json_head;
+    size_t	buflen;
     int		status;
     int		ret;
 
     if (channel_peek(channel, part) == NULL)
 	return FALSE;
 
+    // Decoding an incomplete message would be done again each time more of
+    // it is received, for a long message that is slow.  First check whether
+    // the end was received, continuing where the last check stopped.
+    // When the deadline has passed decode anyway, that drops the message.
+    if (channel_scan_json(channel, part, &buflen) == MAYBE
+		       && !channel_wait_incomplete(channel, chanpart, buflen))
+	return FALSE;
+
     reader.js_buf = channel_get(channel, part, NULL);
     reader.js_used = 0;
     reader.js_fill = channel_fill;
@@ -2237,56 +2467,15 @@ channel_parse_json(channel_T *channel, ch_part_T part)
 	chanpart->ch_wait_len = 0;
     else if (status == MAYBE)
     {
-	size_t buflen = STRLEN(reader.js_buf);
-
-	if (chanpart->ch_wait_len < buflen)
+	if (channel_wait_incomplete(channel, chanpart,
+						      STRLEN(reader.js_buf)))
 	{
-	    // First time encountering incomplete message or after receiving
-	    // more (but still incomplete): set a deadline of 100 msec.
-	    ch_log(channel,
-		    "Incomplete message (%d bytes) - wait 100 msec for more",
-		    (int)buflen);
-	    reader.js_used = 0;
-	    chanpart->ch_wait_len = buflen;
-#ifdef MSWIN
-	    chanpart->ch_deadline = GetTickCount() + 100L;
-#else
-	    gettimeofday(&chanpart->ch_deadline, NULL);
-	    chanpart->ch_deadline.tv_usec += 100 * 1000;
-	    if (chanpart->ch_deadline.tv_usec > 1000 * 1000)
-	    {
-		chanpart->ch_deadline.tv_usec -= 1000 * 1000;
-		++chanpart->ch_deadline.tv_sec;
-	    }
-#endif
+	    status = FAIL;
+	    chanpart->ch_wait_len = 0;
+	    ch_log(channel, "timed out");
 	}
 	else
-	{
-	    int timeout;
-#ifdef MSWIN
-	    timeout = GetTickCount() > chanpart->ch_deadline;
-#else
-	    {
-		struct timeval now_tv;
-
-		gettimeofday(&now_tv, NULL);
-		timeout = now_tv.tv_sec > chanpart->ch_deadline.tv_sec
-		      || (now_tv.tv_sec == chanpart->ch_deadline.tv_sec
-			   && now_tv.tv_usec > chanpart->ch_deadline.tv_usec);
-	    }
-#endif
-	    if (timeout)
-	    {
-		status = FAIL;
-		chanpart->ch_wait_len = 0;
-		ch_log(channel, "timed out");
-	    }
-	    else
-	    {
-		reader.js_used = 0;
-		ch_log(channel, "still waiting on incomplete message");
-	    }
-	}
+	    reader.js_used = 0;
     }
 
     if (status == FAIL)
@@ -3340,6 +3529,13 @@ channel_free_all(void)
     ch_log(NULL, "channel_free_all()");
     FOR_ALL_CHANNELS(channel)
 	channel_clear(channel);
+# ifdef USE_EPOLL
+    if (channel_epoll_fd >= 0)
+    {
+	close(channel_epoll_fd);
+	channel_epoll_fd = -1;
+    }
+# endif
 }
 #endif
 
@@ -4409,6 +4605,11 @@ ch_raw_common(typval_T *argvars, typval_T *rettv, int eval)
 #define KEEP_OPEN_TIME 20  // msec
 
 #if (defined(UNIX) && !defined(HAVE_SELECT)) || defined(PROTO)
+# ifdef USE_EPOLL
+// Index of "channel_epoll_fd" in the poll struct, -1 if not used.
+static int channel_epoll_poll_idx = -1;
+# endif
+
 /*
  * Add open channels to the poll struct.
  * Return the adjusted struct index.
@@ -4422,13 +4623,28 @@ channel_poll_setup(int nfd_in, void *fds_in, int *towait)
     struct	pollfd *fds = fds_in;
     ch_part_T	part;
 
+# ifdef USE_EPOLL
+    channel_epoll_poll_idx = -1;
+    if (channel_epoll_fd >= 0)
+    {
+	channel_epoll_poll_idx = nfd;
+	fds[nfd].fd = channel_epoll_fd;
+	fds[nfd].events = POLLIN;
+	nfd++;
+    }
+    if (channel_epoll_poll_count > 0)
+# endif
     FOR_ALL_CHANNELS(channel)
     {
 	for (part = PART_SOCK; part < PART_IN; ++part)
 	{
 	    chanpart_T	*ch_part = &channel->ch_part[part];
 
-	    if (ch_part->ch_fd != INVALID_FD)
+	    if (ch_part->ch_fd != INVALID_FD
+# ifdef USE_EPOLL
+		    && ch_part->ch_epoll_state == EPOLL_POLL
+# endif
+		    )
 	    {
 		if (channel->ch_keep_open)
 		{
@@ -4469,10 +4685,26 @@ channel_poll_check(int ret_in, void *fds_in)
     int		idx;
     chanpart_T	*in_part;
 
+# ifdef USE_EPOLL
+    if (ret > 0 && channel_epoll_poll_idx != -1
+			&& (fds[channel_epoll_poll_idx].revents & POLLIN))
+    {
+	channel_epoll_check();
+	--ret;
+    }
+    // Only write fds and polled parts are left to check.
+    if (ret == 0 && channel_epoll_poll_count == 0)
+	return ret;
+# endif
+
     FOR_ALL_CHANNELS(channel)
     {
 	for (part = PART_SOCK; part < PART_IN; ++part)
 	{
+# ifdef USE_EPOLL
+	    if (channel->ch_part[part].ch_epoll_state != EPOLL_POLL)
+		continue;
+# endif
 	    idx = channel->ch_part[part].ch_poll_idx;
 
 	    if (ret > 0 && idx != -1 && (fds[idx].revents & POLLIN))
@@ -4520,13 +4752,26 @@ channel_select_setup(
     fd_set	*wfds = wfds_in;
     ch_part_T	part;
 
+# ifdef USE_EPOLL
+    if (channel_epoll_fd >= 0)
+    {
+	FD_SET(channel_epoll_fd, rfds);
+	if (maxfd < channel_epoll_fd)
+	    maxfd = channel_epoll_fd;
+    }
+    if (channel_epoll_poll_count > 0)
+# endif
     FOR_ALL_CHANNELS(channel)
     {
 	for (part = PART_SOCK; part < PART_IN; ++part)
 	{
 	    sock_T fd = channel->ch_part[part].ch_fd;
 
-	    if (fd != INVALID_FD)
+	    if (fd != INVALID_FD
+# ifdef USE_EPOLL
+		    && channel->ch_part[part].ch_epoll_state == EPOLL_POLL
+# endif
+		    )
 	    {
 		if (channel->ch_keep_open)
 		{
@@ -4569,12 +4814,28 @@ channel_select_check(int ret_in, void *rfds_in, void *wfds_in)
     ch_part_T	part;
     chanpart_T	*in_part;
 
+# ifdef USE_EPOLL
+    if (ret > 0 && channel_epoll_fd >= 0 && FD_ISSET(channel_epoll_fd, rfds))
+    {
+	FD_CLR(channel_epoll_fd, rfds);
+	channel_epoll_check();
+	--ret;
+    }
+    // Only write fds and polled parts are left to check.
+    if (ret == 0 && channel_epoll_poll_count == 0)
+	return ret;
+# endif
+
     FOR_ALL_CHANNELS(channel)
     {
 	for (part = PART_SOCK; part < PART_IN; ++part)
 	{
 	    sock_T fd = channel->ch_part[part].ch_fd;
 
+# ifdef USE_EPOLL
+	    if (channel->ch_part[part].ch_epoll_state != EPOLL_POLL)
+		continue;
+# endif
 	    if (ret > 0 && fd != INVALID_FD && FD_ISSET(fd, rfds))
 	    {
 		channel_read(channel, part, "channel_select_check");
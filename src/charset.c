@@ -81,6 +81,7 @@ buf_init_chartab(
     int		tilde;
     int		do_isalpha;
 
+    ++chartab_tick;
     if (global)
     {
 	/*
@@ -104,6 +104,9 @@ update_screen(int type_arg)
 	type = 0;
     }
 
+    // Collect the output, it is written at once when flushed.
+    out_frame_start();
+
 #ifdef FEAT_EVAL
     {
 	buf_T *buf;
@@ -2954,6 +2957,7 @@ redraw_after_callback(int call_update_screen)
 	update_screen(VALID_NO_UPDATE);
 	setcursor();
     }
+    screen_flush_clear();
     cursor_on();
 #ifdef FEAT_GUI
     if (gui.in_use && !gui_mch_is_blink_off())
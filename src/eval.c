@@ -1676,12 +1676,12 @@ pattern_match(char_u *pat, char_u *text, int ic)
     // avoid 'l' flag in 'cpoptions'
     save_cpo = p_cpo;
     p_cpo = (char_u *)"";
-    regmatch.regprog = vim_regcomp(pat, RE_MAGIC + RE_STRING);
+    regmatch.regprog = vim_regcomp_reuse(pat, RE_MAGIC + RE_STRING);
     if (regmatch.regprog != NULL)
     {
 	regmatch.rm_ic = ic;
 	matches = vim_regexec_nl(&regmatch, text, (colnr_T)0);
-	vim_regfree(regmatch.regprog);
+	vim_regfree_reuse(regmatch.regprog, pat, RE_MAGIC + RE_STRING);
     }
     p_cpo = save_cpo;
     return matches;
@@ -6641,7 +6641,7 @@ do_string_sub(
     do_all = (flags[0] == 'g');
 
     regmatch.rm_ic = p_ic;
-    regmatch.regprog = vim_regcomp(pat, RE_MAGIC + RE_STRING);
+    regmatch.regprog = vim_regcomp_reuse(pat, RE_MAGIC + RE_STRING);
     if (regmatch.regprog != NULL)
     {
 	tail = str;
@@ -6696,7 +6696,7 @@ do_string_sub(
 	if (ga.ga_data != NULL)
 	    STRCPY((char *)ga.ga_data + ga.ga_len, tail);
 
-	vim_regfree(regmatch.regprog);
+	vim_regfree_reuse(regmatch.regprog, pat, RE_MAGIC + RE_STRING);
     }
 
     ret = vim_strsave(ga.ga_data == NULL ? str : (char_u *)ga.ga_data);
@@ -458,7 +458,6 @@ f_deletebufline(typval_T *argvars, typval_T *rettv)
 {
     buf_T	*buf;
     linenr_T	first, last;
-    linenr_T	lnum;
     long	count;
     int		is_curbuf;
     buf_T	*curbuf_save = NULL;
@@ -512,8 +511,7 @@ f_deletebufline(typval_T *argvars, typval_T *rettv)
 	return;
     }
 
-    for (lnum = first; lnum <= last; ++lnum)
-	ml_delete(first, TRUE);
+    ml_delete_lines(first, count, TRUE);
 
     FOR_ALL_TAB_WINDOWS(tp, wp)
 	if (wp->w_buffer == buf)
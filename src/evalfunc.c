@@ -4476,6 +4476,13 @@ f_has(typval_T *argvars, typval_T *rettv)
 #endif
 		},
 	{"vertsplit", 1},
+	{"vim9_threaded",
+#ifdef FEAT_VIM9_THREADED
+		1
+#else
+		0
+#endif
+		},
 	{"viminfo",
 #ifdef FEAT_VIMINFO
 		1
@@ -5581,7 +5588,7 @@ find_some_match(typval_T *argvars, typval_T *rettv, matchtype_T type)
 	    goto theend;
     }
 
-    regmatch.regprog = vim_regcomp(pat, RE_MAGIC + RE_STRING);
+    regmatch.regprog = vim_regcomp_reuse(pat, RE_MAGIC + RE_STRING);
     if (regmatch.regprog != NULL)
     {
 	regmatch.rm_ic = p_ic;
@@ -5688,7 +5695,7 @@ find_some_match(typval_T *argvars, typval_T *rettv, matchtype_T type)
 		rettv->vval.v_number += (varnumber_T)(str - expr);
 	    }
 	}
-	vim_regfree(regmatch.regprog);
+	vim_regfree_reuse(regmatch.regprog, pat, RE_MAGIC + RE_STRING);
     }
 
 theend:
@@ -7710,7 +7717,7 @@ f_split(typval_T *argvars, typval_T *rettv)
     if (typeerr)
 	return;
 
-    regmatch.regprog = vim_regcomp(pat, RE_MAGIC + RE_STRING);
+    regmatch.regprog = vim_regcomp_reuse(pat, RE_MAGIC + RE_STRING);
     if (regmatch.regprog != NULL)
     {
 	regmatch.rm_ic = FALSE;
@@ -7742,7 +7749,7 @@ f_split(typval_T *argvars, typval_T *rettv)
 	    str = regmatch.endp[0];
 	}
 
-	vim_regfree(regmatch.regprog);
+	vim_regfree_reuse(regmatch.regprog, pat, RE_MAGIC + RE_STRING);
     }
 
     p_cpo = save_cpo;
@@ -297,6 +297,19 @@
 # define HAVE_SANDBOX
 #endif
 
+/*
+ * +vim9_threaded	Execute the instructions of compiled functions with
+ *			direct threading: each instruction holds the address of
+ *			the code executing it, which is jumped to with a
+ *			computed goto instead of going through a switch.
+ *			Requires "labels as values" (gcc and clang).
+ *			Define NO_VIM9_THREADED to use the switch.
+ */
+// #define NO_VIM9_THREADED
+#if defined(FEAT_EVAL) && defined(__GNUC__) && !defined(NO_VIM9_THREADED)
+# define FEAT_VIM9_THREADED
+#endif
+
 /*
  * +profile		Profiling for functions and scripts.
  */
@@ -1160,6 +1173,16 @@
 # undef FEAT_JOB_CHANNEL
 #endif
 
+/*
+ * On Linux the channel file descriptors are registered with epoll once, so
+ * that waiting for input does not need to pass every channel to select() or
+ * poll().
+ */
+#if defined(FEAT_JOB_CHANNEL) && defined(HAVE_SYS_EPOLL_H) \
+	&& !defined(NO_EPOLL)
+# define USE_EPOLL
+#endif
+
 /*
  * +terminal		":terminal" command.  Runs a terminal in a window.
  *			requires +channel
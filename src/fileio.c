@@ -28,6 +28,8 @@ static char_u *readfile_charconvert(char_u *fname, char_u *fenc, int *fdp);
 static char_u *check_for_cryptkey(char_u *cryptkey, char_u *ptr, long *sizep, off_T *filesizep, int newfile, char_u *fname, int *did_ask);
 #endif
 static linenr_T readfile_linenr(linenr_T linecnt, char_u *p, char_u *endp);
+static long readfile_ascii_len(char_u *p, long len);
+static long readfile_text_len(char_u *p, long len);
 static char_u *check_for_bom(char_u *p, long size, int *lenp, int flags);
 static char *e_auchangedbuf = N_("E812: Autocommands changed buffer or buffer name");
 
@@ -1922,9 +1924,12 @@ retry:
 		// Reading UTF-8: Check if the bytes are valid UTF-8.
 		for (p = ptr; ; ++p)
 		{
-		    int	 todo = (int)((ptr + size) - p);
+		    int	 todo;
 		    int	 l;
 
+		    // Quickly skip over ASCII, it is always valid.
+		    p += readfile_ascii_len(p, (long)((ptr + size) - p));
+		    todo = (int)((ptr + size) - p);
 		    if (todo <= 0)
 			break;
 		    if (*p >= 0x80)
@@ -2119,12 +2124,18 @@ rewind_retry:
 	}
 	else
 	{
+	    long	textlen;
+
 	    --ptr;
 	    while (++ptr, --size >= 0)
 	    {
-		if ((c = *ptr) != NUL && c != NL)  // catch most common case
-		    continue;
-		if (c == NUL)
+		// catch most common case: skip over the text of the line
+		textlen = readfile_text_len(ptr, size + 1);
+		ptr += textlen;
+		size -= textlen;
+		if (size < 0)
+		    break;
+		if ((c = *ptr) == NUL)
 		    *ptr = NL;	// NULs are replaced by newlines!
 		else
 		{
@@ -2626,6 +2637,59 @@ readfile_linenr(
     return lnum;
 }
 
+/*
+ * Checking the bytes read from a file is done a machine word at a time.
+ * HAS_ZERO_BYTE() is non-zero when one of the bytes in "w" is zero.
+ */
+#define ONES_WORD	((long_u)-1 / 0xff)	// 0x0101...01
+#define HIGHS_WORD	(ONES_WORD * 0x80)	// 0x8080...80
+#define HAS_ZERO_BYTE(w)  (((w) - ONES_WORD) & ~(w) & HIGHS_WORD)
+
+/*
+ * Return the number of bytes at "p", at most "len", that are ASCII.
+ */
+    static long
+readfile_ascii_len(char_u *p, long len)
+{
+    char_u	*s = p;
+    char_u	*e = p + len;
+    long_u	w;
+
+    while (e - s >= (long)sizeof(long_u))
+    {
+	mch_memmove(&w, s, sizeof(long_u));
+	if (w & HIGHS_WORD)
+	    break;
+	s += sizeof(long_u);
+    }
+    while (s < e && *s < 0x80)
+	++s;
+    return (long)(s - p);
+}
+
+/*
+ * Return the number of bytes at "p", at most "len", before the first NL or
+ * NUL.
+ */
+    static long
+readfile_text_len(char_u *p, long len)
+{
+    char_u	*s = p;
+    char_u	*e = p + len;
+    long_u	w;
+
+    while (e - s >= (long)sizeof(long_u))
+    {
+	mch_memmove(&w, s, sizeof(long_u));
+	if (HAS_ZERO_BYTE(w) || HAS_ZERO_BYTE(w ^ (ONES_WORD * NL)))
+	    break;
+	s += sizeof(long_u);
+    }
+    while (s < e && *s != NL && *s != NUL)
+	++s;
+    return (long)(s - p);
+}
+
 /*
  * Fill "*eap" to force the 'fileencoding', 'fileformat' and 'binary to be
  * equal to the buffer "buf".  Used for calling readfile().
@@ -3411,7 +3411,10 @@ inchar(
 	 * from the user and not just peeking.
 	 */
 	if (wait_time == -1L || wait_time > 10L)
+	{
+	    screen_flush_clear();
 	    out_flush();
+	}
 
 	/*
 	 * Fill up to a third of the buffer, because each character may be
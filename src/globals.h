@@ -973,6 +973,12 @@ EXTERN int	has_mbyte INIT(= 0);		// any multi-byte encoding
  */
 EXTERN char	mb_bytelen_tab[256];
 
+/*
+ * Incremented whenever the character classes for 'iskeyword', 'isident',
+ * 'isfname' or 'isprint' are set, used to invalidate cached results.
+ */
+EXTERN int	chartab_tick INIT(= 0);
+
 // Variables that tell what conversion is used for keyboard input and display
 // output.
 EXTERN vimconv_T input_conv;			// type of input conversion
@@ -1174,6 +1180,8 @@ EXTERN int	term_console INIT(= FALSE); // set to TRUE when console used
 #endif
 EXTERN int	termcap_active INIT(= FALSE);	// set by starttermcap()
 EXTERN tmode_T	cur_tmode INIT(= TMODE_COOK);	// input terminal mode
+EXTERN long	term_frame_bytes INIT(= 0);	// bytes written for last frame
+EXTERN long	term_frame_writes INIT(= 0);	// writes done for last frame
 EXTERN int	bangredo INIT(= FALSE);	    // set to TRUE with ! command
 EXTERN int	searchcmdlen;		    // length of previous search cmd
 #ifdef FEAT_SYN_HL
@@ -19,8 +19,17 @@
  * To make the iteration work removed keys are different from entries where a
  * key was never present.
  *
- * The mechanism has been partly based on how Python Dictionaries are
- * implemented.  The algorithm is from Knuth Vol. 3, Sec. 6.4.
+ * Besides the array of items there is an array with a control byte for each
+ * item: HT_CTRL_EMPTY, HT_CTRL_REMOVED or the top bits of the hash with the
+ * high bit set.  A lookup checks the control bytes of HT_GROUP_SIZE items at
+ * once, using SSE2 when available, and only looks at the items where the
+ * control byte matches.  It stops at the first group with an empty item.
+ * The first HT_GROUP_SIZE - 1 control bytes are copied after the last one,
+ * so that a group can start anywhere.  This is the layout of the "Swiss
+ * table" used by Abseil.
+ *
+ * The items themselves are not moved, iterating over "ht_array" and checking
+ * with HASHITEM_EMPTY() works as before.
  *
  * The hashtable grows to accommodate more entries when needed.  At least 1/3
  * of the entries is empty to keep the lookup efficient (at the cost of extra
@@ -29,6 +38,12 @@
 
 #include "vim.h"
 
+#if defined(__SSE2__) || defined(_M_X64) \
+				     || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define HT_USE_SSE2
+#endif
+
 #if 0
 # define HT_DEBUG	// extra checks for table consistency  and statistics
 
@@ -36,8 +51,28 @@ static long hash_count_lookup = 0;	// count number of hashtab lookups
 static long hash_count_perturb = 0;	// count number of "misses"
 #endif
 
-// Magic value for algorithm that walks through the array.
-#define PERTURB_SHIFT 5
+// Control byte values.  A used item has the high bit set.
+#define HT_CTRL_EMPTY	0
+#define HT_CTRL_REMOVED	1
+
+// The control byte for an item with hash "hash".  The low bits of the hash
+// are used for the index, the hash is multiplied to let the top seven bits
+// depend on all of it.  hash_hash() itself is not changed, it determines the
+// order in which items are found when iterating.
+#if defined(_WIN64) || (defined(VIM_SIZEOF_LONG) && VIM_SIZEOF_LONG > 4)
+# define HT_CTRL(hash) \
+	    ((int)(((hash) * (hash_T)0x9e3779b97f4a7c15ULL) >> 57) | 0x80)
+#else
+# define HT_CTRL(hash) \
+	    ((int)(((hash) * (hash_T)0x9e3779b1UL) >> 25) | 0x80)
+#endif
+
+// Source of the "ht_changed" stamps.  Since the counter is shared by all
+// hashtables a stamp is never used twice, also not when a hashtable is freed
+// and another one is allocated in the same place.
+static long_u hash_changed_count = 0;
+
+#define HASH_CHANGED(ht) (ht)->ht_changed = ++hash_changed_count
 
 static int hash_may_resize(hashtab_T *ht, int minitems);
 
@@ -65,9 +100,67 @@ hash_create(void)
 hash_init(hashtab_T *ht)
 {
     // This zeroes all "ht_" entries and all the "hi_key" in "ht_smallarray".
+    // All the control bytes become HT_CTRL_EMPTY.
     CLEAR_POINTER(ht);
     ht->ht_array = ht->ht_smallarray;
+    ht->ht_ctrl = ht->ht_smallctrl;
     ht->ht_mask = HT_INIT_SIZE - 1;
+    HASH_CHANGED(ht);
+}
+
+/*
+ * Return a bit mask with bit N set when control byte "ctrl[N]" is "c", for
+ * HT_GROUP_SIZE bytes.
+ */
+    static unsigned
+group_match(char_u *ctrl, int c)
+{
+#ifdef HT_USE_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+    return (unsigned)_mm_movemask_epi8(
+				_mm_cmpeq_epi8(group, _mm_set1_epi8((char)c)));
+#else
+    unsigned	mask = 0;
+    int		i;
+
+    for (i = 0; i < HT_GROUP_SIZE; ++i)
+	if (ctrl[i] == c)
+	    mask |= 1U << i;
+    return mask;
+#endif
+}
+
+/*
+ * Return the index of the lowest bit set in "mask", which is not zero.
+ */
+    static int
+lowest_bit(unsigned mask)
+{
+#ifdef __GNUC__
+    return __builtin_ctz(mask);
+#else
+    int	n = 0;
+
+    while ((mask & 1) == 0)
+    {
+	mask >>= 1;
+	++n;
+    }
+    return n;
+#endif
+}
+
+/*
+ * Set control byte "c" for item "idx" in "ctrl" of a table with "mask", also
+ * in the copy after the end.
+ */
+    static void
+set_ctrl(char_u *ctrl, long_u mask, long_u idx, int c)
+{
+    ctrl[idx] = c;
+    if (idx < HT_GROUP_SIZE - 1)
+	ctrl[mask + 1 + idx] = c;
 }
 
 /*
@@ -79,6 +172,7 @@ hash_clear(hashtab_T *ht)
 {
     if (ht->ht_array != ht->ht_smallarray)
 	vim_free(ht->ht_array);
+    HASH_CHANGED(ht);
 }
 
 #if defined(FEAT_SPELL) || defined(PROTO)
@@ -126,57 +220,49 @@ hash_find(hashtab_T *ht, char_u *key)
     hashitem_T *
 hash_lookup(hashtab_T *ht, char_u *key, hash_T hash)
 {
-    hash_T	perturb;
-    hashitem_T	*freeitem;
+    long_u	mask = ht->ht_mask;
+    long_u	idx = hash & mask;
+    long_u	step = 0;
+    int		c = HT_CTRL(hash);
+    hashitem_T	*freeitem = NULL;
     hashitem_T	*hi;
-    unsigned	idx;
+    char_u	*group;
+    unsigned	match;
 
 #ifdef HT_DEBUG
     ++hash_count_lookup;
 #endif
 
     /*
-     * Quickly handle the most common situations:
-     * - return if there is no item at all
-     * - skip over a removed item
-     * - return if the item matches
+     * Check a group of control bytes at a time, starting at the item for the
+     * hash, for items where the control byte matches.  When the group has an
+     * empty item it's clear that the key isn't there.  Return the first
+     * available slot found (can be a slot of a removed item).
+     * Otherwise step to the next group, with increasing steps.  Since the
+     * table size is a power of two this goes through all table entries in
+     * the end.
      */
-    idx = (unsigned)(hash & ht->ht_mask);
-    hi = &ht->ht_array[idx];
-
-    if (hi->hi_key == NULL)
-	return hi;
-    if (hi->hi_key == HI_KEY_REMOVED)
-	freeitem = hi;
-    else if (hi->hi_hash == hash && STRCMP(hi->hi_key, key) == 0)
-	return hi;
-    else
-	freeitem = NULL;
-
-    /*
-     * Need to search through the table to find the key.  The algorithm
-     * to step through the table starts with large steps, gradually becoming
-     * smaller down to (1/4 table size + 1).  This means it goes through all
-     * table entries in the end.
-     * When we run into a NULL key it's clear that the key isn't there.
-     * Return the first available slot found (can be a slot of a removed
-     * item).
-     */
-    for (perturb = hash; ; perturb >>= PERTURB_SHIFT)
+    for (;;)
     {
+	group = ht->ht_ctrl + idx;
+	for (match = group_match(group, c); match != 0; match &= match - 1)
+	{
+	    hi = &ht->ht_array[(idx + lowest_bit(match)) & mask];
+	    if (hi->hi_hash == hash && STRCMP(hi->hi_key, key) == 0)
+		return hi;
+	}
+	if (freeitem == NULL
+		&& (match = group_match(group, HT_CTRL_REMOVED)) != 0)
+	    freeitem = &ht->ht_array[(idx + lowest_bit(match)) & mask];
+	if ((match = group_match(group, HT_CTRL_EMPTY)) != 0)
+	    return freeitem != NULL ? freeitem
+			     : &ht->ht_array[(idx + lowest_bit(match)) & mask];
+
 #ifdef HT_DEBUG
 	++hash_count_perturb;	    // count a "miss" for hashtab lookup
 #endif
-	idx = (unsigned)((idx << 2U) + idx + perturb + 1U);
-	hi = &ht->ht_array[idx & ht->ht_mask];
-	if (hi->hi_key == NULL)
-	    return freeitem == NULL ? hi : freeitem;
-	if (hi->hi_hash == hash
-		&& hi->hi_key != HI_KEY_REMOVED
-		&& STRCMP(hi->hi_key, key) == 0)
-	    return hi;
-	if (hi->hi_key == HI_KEY_REMOVED && freeitem == NULL)
-	    freeitem = hi;
+	step += HT_GROUP_SIZE;
+	idx = (idx + step) & mask;
     }
 }
 
@@ -192,8 +278,8 @@ hash_debug_results(void)
 #ifdef HT_DEBUG
     fprintf(stderr, "\r\n\r\n\r\n\r\n");
     fprintf(stderr, "Number of hashtable lookups: %ld\r\n", hash_count_lookup);
-    fprintf(stderr, "Number of perturb loops: %ld\r\n", hash_count_perturb);
-    fprintf(stderr, "Percentage of perturb loops: %ld%%\r\n",
+    fprintf(stderr, "Number of group steps: %ld\r\n", hash_count_perturb);
+    fprintf(stderr, "Percentage of group steps: %ld%%\r\n",
 				hash_count_perturb * 100 / hash_count_lookup);
 #endif
 }
@@ -240,6 +326,8 @@ hash_add_item(
 	++ht->ht_filled;
     hi->hi_key = key;
     hi->hi_hash = hash;
+    set_ctrl(ht->ht_ctrl, ht->ht_mask, hi - ht->ht_array, HT_CTRL(hash));
+    HASH_CHANGED(ht);
 
     // When the space gets low may resize the array.
     return hash_may_resize(ht, 0);
@@ -272,6 +360,8 @@ hash_remove(hashtab_T *ht, hashitem_T *hi)
 {
     --ht->ht_used;
     hi->hi_key = HI_KEY_REMOVED;
+    set_ctrl(ht->ht_ctrl, ht->ht_mask, hi - ht->ht_array, HT_CTRL_REMOVED);
+    HASH_CHANGED(ht);
     hash_may_resize(ht, 0);
 }
 
@@ -322,13 +412,15 @@ hash_may_resize(
 {
     hashitem_T	temparray[HT_INIT_SIZE];
     hashitem_T	*oldarray, *newarray;
-    hashitem_T	*olditem, *newitem;
-    unsigned	newi;
+    hashitem_T	*olditem;
+    char_u	*newctrl;
+    long_u	newi;
+    long_u	step;
+    unsigned	match;
     int		todo;
     long_u	oldsize, newsize;
     long_u	minsize;
     long_u	newmask;
-    hash_T	perturb;
 
     // Don't resize a locked table.
     if (ht->ht_locked > 0)
@@ -384,6 +476,7 @@ hash_may_resize(
     {
 	// Use the small array inside the hashdict structure.
 	newarray = ht->ht_smallarray;
+	newctrl = ht->ht_smallctrl;
 	if (ht->ht_array == newarray)
 	{
 	    // Moving from ht_smallarray to ht_smallarray!  Happens when there
@@ -395,11 +488,13 @@ hash_may_resize(
 	else
 	    oldarray = ht->ht_array;
 	CLEAR_FIELD(ht->ht_smallarray);
+	CLEAR_FIELD(ht->ht_smallctrl);
     }
     else
     {
-	// Allocate an array.
-	newarray = ALLOC_CLEAR_MULT(hashitem_T, newsize);
+	// Allocate an array, with the control bytes after the items.
+	newarray = alloc_clear(newsize * sizeof(hashitem_T)
+					       + newsize + HT_GROUP_SIZE - 1);
 	if (newarray == NULL)
 	{
 	    // Out of memory.  When there are NULL items still return OK.
@@ -410,6 +505,7 @@ hash_may_resize(
 	    ht->ht_error = TRUE;
 	    return FAIL;
 	}
+	newctrl = (char_u *)(newarray + newsize);
 	oldarray = ht->ht_array;
     }
 
@@ -426,29 +522,29 @@ hash_may_resize(
 	    /*
 	     * The algorithm to find the spot to add the item is identical to
 	     * the algorithm to find an item in hash_lookup().  But we only
-	     * need to search for a NULL key, thus it's simpler.
+	     * need to search for an empty item, thus it's simpler.
 	     */
-	    newi = (unsigned)(olditem->hi_hash & newmask);
-	    newitem = &newarray[newi];
-
-	    if (newitem->hi_key != NULL)
-		for (perturb = olditem->hi_hash; ; perturb >>= PERTURB_SHIFT)
-		{
-		    newi = (unsigned)((newi << 2U) + newi + perturb + 1U);
-		    newitem = &newarray[newi & newmask];
-		    if (newitem->hi_key == NULL)
-			break;
-		}
-	    *newitem = *olditem;
+	    newi = olditem->hi_hash & newmask;
+	    step = 0;
+	    while ((match = group_match(newctrl + newi, HT_CTRL_EMPTY)) == 0)
+	    {
+		step += HT_GROUP_SIZE;
+		newi = (newi + step) & newmask;
+	    }
+	    newi = (newi + lowest_bit(match)) & newmask;
+	    newarray[newi] = *olditem;
+	    set_ctrl(newctrl, newmask, newi, HT_CTRL(olditem->hi_hash));
 	    --todo;
 	}
 
     if (ht->ht_array != ht->ht_smallarray)
 	vim_free(ht->ht_array);
     ht->ht_array = newarray;
+    ht->ht_ctrl = newctrl;
     ht->ht_mask = newmask;
     ht->ht_filled = ht->ht_used;
     ht->ht_error = FALSE;
+    HASH_CHANGED(ht);
 
     return OK;
 }
@@ -16,6 +16,12 @@
 
 #include "vim.h"
 
+#if defined(__SSE2__) || defined(_M_X64) \
+				     || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define JSON_USE_SSE2
+#endif
+
 #if defined(FEAT_EVAL) || defined(PROTO)
 
 static int json_encode_item(garray_T *gap, typval_T *val, int copyID, int options);
@@ -90,10 +96,46 @@ json_encode_nr_expr(int nr, typval_T *val, int options)
 }
 #endif
 
+/*
+ * Return the number of bytes from "p" up to "end" that can be copied into a
+ * JSON string as they are: ASCII characters other than a control character,
+ * double quote or backslash.
+ */
+    static int
+json_plain_len(char_u *p, char_u *end)
+{
+    char_u	*s = p;
+
+#ifdef JSON_USE_SSE2
+    __m128i	space = _mm_set1_epi8(' ');
+    __m128i	quote = _mm_set1_epi8('"');
+    __m128i	backslash = _mm_set1_epi8('\\');
+
+    // Check 16 bytes at a time.  As signed bytes both control characters and
+    // non-ASCII bytes are less than a space.
+    while (end - s >= 16)
+    {
+	__m128i	v = _mm_loadu_si128((const __m128i *)s);
+	__m128i	special = _mm_or_si128(_mm_cmplt_epi8(v, space),
+					_mm_or_si128(_mm_cmpeq_epi8(v, quote),
+					       _mm_cmpeq_epi8(v, backslash)));
+
+	if (_mm_movemask_epi8(special) != 0)
+	    break;
+	s += 16;
+    }
+#endif
+    while (s < end && *s >= ' ' && *s < 0x80 && *s != '"' && *s != '\\')
+	++s;
+    return (int)(s - p);
+}
+
     static void
 write_string(garray_T *gap, char_u *str)
 {
     char_u	*res = str;
+    char_u	*end;
+    int		len;
     char_u	numbuf[NUMBUFLEN];
 
     if (res == NULL)
@@ -115,10 +157,24 @@ write_string(garray_T *gap, char_u *str)
 	    convert_setup(&conv, NULL, NULL);
 	}
 #endif
+	end = res + STRLEN(res);
+	// Most of the string is usually copied as-is, make room for it once.
+	(void)ga_grow(gap, (int)(end - res) + 2);
 	ga_append(gap, '"');
-	while (*res != NUL)
+	while (res < end)
 	{
 	    int c;
+
+	    // Copy a sequence of characters that don't need escaping at once.
+	    len = json_plain_len(res, end);
+	    if (len > 0)
+	    {
+		ga_concat_len(gap, res, len);
+		res += len;
+		if (res == end)
+		    break;
+	    }
+
 	    // always use utf-8 encoding, ignore 'encoding'
 	    c = utf_ptr2char(res);
 
@@ -413,10 +469,27 @@ json_decode_string(js_read_T *reader, typval_T *res, int quote)
     int		c;
     varnumber_T	nr;
 
+    p = reader->js_buf + reader->js_used + 1; // skip over " or '
+    if (res != NULL && enc_utf8)
+    {
+	char_u	*e = p;
+
+	// Most strings don't have a backslash, copy them in one go.
+	while (*e != quote && *e != '\\' && *e != NUL && e[1] != NUL
+				      && utf_ptr2len(e) >= utf_byte2len(*e))
+	    e += utf_ptr2len(e);
+	if (*e == quote)
+	{
+	    res->v_type = VAR_STRING;
+	    res->vval.v_string = vim_strnsave(p, (int)(e - p));
+	    reader->js_used = (int)(e + 1 - reader->js_buf);
+	    return OK;
+	}
+    }
+
     if (res != NULL)
 	ga_init2(&ga, 1, 200);
 
-    p = reader->js_buf + reader->js_used + 1; // skip over " or '
     while (*p != quote)
     {
 	// The JSON is always expected to be utf-8, thus use utf functions
@@ -1116,6 +1189,56 @@ json_decode(js_read_T *reader, typval_T *res, int options)
 }
 #endif
 
+#if defined(FEAT_JOB_CHANNEL) || defined(PROTO)
+/*
+ * Continue finding the end of a JSON message in "buf[len]", which follows
+ * what was scanned before with "js".  Only handles a message that is an
+ * array, object or string, which can be done without decoding it.
+ * "options" can be JSON_JS or zero.
+ * Return OK when the end was found, "js->jsc_used" is then just after it.
+ * Return MAYBE when the message is incomplete.
+ * Return FAIL when the message has to be decoded to find the end.
+ */
+    int
+json_scan(json_scan_T *js, char_u *buf, long_u len, int options)
+{
+    char_u	*p;
+
+    for (p = buf; !js->jsc_done && !js->jsc_fail && p < buf + len; ++p)
+    {
+	++js->jsc_used;
+	if (js->jsc_quote != NUL)
+	{
+	    if (js->jsc_escape)
+		js->jsc_escape = FALSE;
+	    else if (*p == '\\')
+		js->jsc_escape = TRUE;
+	    else if (*p == js->jsc_quote)
+	    {
+		js->jsc_quote = NUL;
+		if (js->jsc_depth == 0)
+		    js->jsc_done = TRUE;
+	    }
+	}
+	else if (*p == '"' || (*p == '\'' && (options & JSON_JS)))
+	    js->jsc_quote = *p;
+	else if (*p == '[' || *p == '{')
+	    ++js->jsc_depth;
+	else if (*p == ']' || *p == '}')
+	{
+	    if (js->jsc_depth == 0)
+		js->jsc_fail = TRUE;
+	    else if (--js->jsc_depth == 0)
+		js->jsc_done = TRUE;
+	}
+	else if (*p == NUL || (*p > ' ' && js->jsc_depth == 0))
+	    // a NUL or a number or name at the toplevel
+	    js->jsc_fail = TRUE;
+    }
+    return js->jsc_fail ? FAIL : js->jsc_done ? OK : MAYBE;
+}
+#endif
+
 /*
  * Decode the JSON from "reader" to find the end of the message.
  * "options" can be JSON_JS or zero.
@@ -25,6 +25,11 @@ static list_T		*first_list = NULL;	// list of all lists
 
 static void list_free_item(list_T *l, listitem_T *item);
 
+// A list gets an index when list_find() has to go through this many items
+// or more.  Must be more than the number of items in a static list or a:000,
+// these are never freed.
+#define LIST_INDEX_MIN_LEN 32
+
 /*
  * Add a watcher to a list.
  */
@@ -270,6 +275,7 @@ list_free_list(list_T  *l)
     if (l->lv_used_next != NULL)
 	l->lv_used_next->lv_used_prev = l->lv_used_prev;
 
+    vim_free(l->lv_index);
     vim_free(l);
 }
 
@@ -389,6 +395,34 @@ list_equal(
     return item1 == NULL && item2 == NULL;
 }
 
+/*
+ * Free the index of list "l", after the order of the items was changed.
+ */
+    static void
+list_index_clear(list_T *l)
+{
+    VIM_CLEAR(l->lv_index);
+    l->lv_index_size = 0;
+}
+
+/*
+ * Create the index of list "l", so that list_find() does not need to go
+ * through the items.  Nothing happens when out of memory.
+ */
+    static void
+list_index_create(list_T *l)
+{
+    listitem_T	*item;
+    int		i = 0;
+
+    l->lv_index = ALLOC_MULT(listitem_T *, l->lv_len);
+    if (l->lv_index == NULL)
+	return;
+    l->lv_index_size = l->lv_len;
+    FOR_ALL_LIST_ITEMS(l, item)
+	l->lv_index[i++] = item;
+}
+
 /*
  * Locate item with index "n" in list "l" and return it.
  * A negative index is counted from the end; -1 is the last item.
@@ -399,6 +433,7 @@ list_find(list_T *l, long n)
 {
     listitem_T	*item;
     long	idx;
+    long	start_idx;
 
     if (l == NULL)
 	return NULL;
@@ -413,6 +448,14 @@ list_find(list_T *l, long n)
 
     CHECK_LIST_MATERIALIZE(l);
 
+    if (l->lv_index != NULL)
+    {
+	item = l->lv_index[n];
+	l->lv_u.mat.lv_idx = n;
+	l->lv_u.mat.lv_idx_item = item;
+	return item;
+    }
+
     // When there is a cached index may start search from there.
     if (l->lv_u.mat.lv_idx_item != NULL)
     {
@@ -450,6 +493,7 @@ list_find(list_T *l, long n)
 	    idx = l->lv_len - 1;
 	}
     }
+    start_idx = idx;
 
     while (n > idx)
     {
@@ -468,6 +512,14 @@ list_find(list_T *l, long n)
     l->lv_u.mat.lv_idx = idx;
     l->lv_u.mat.lv_idx_item = item;
 
+    // When going through many items the list is probably not used in order,
+    // create an index for the next time.  Not for a list that is not freed.
+    if (l->lv_len >= LIST_INDEX_MIN_LEN
+	    && (n > start_idx ? n - start_idx : start_idx - n)
+							 >= LIST_INDEX_MIN_LEN
+	    && l->lv_refcount != DO_NOT_FREE_CNT)
+	list_index_create(l);
+
     return item;
 }
 
@@ -552,11 +604,32 @@ list_idx_of_item(list_T *l, listitem_T *item)
 
 /*
  * Append item "item" to the end of list "l".
+ * Also used to put all the items back in another order, after setting
+ * "lv_len" to zero, that also puts them in the right place in "lv_index".
  */
     void
 list_append(list_T *l, listitem_T *item)
 {
     CHECK_LIST_MATERIALIZE(l);
+    if (l->lv_index != NULL)
+    {
+	if (l->lv_len == l->lv_index_size)
+	{
+	    int		newsize = l->lv_index_size * 3 / 2 + 4;
+	    listitem_T	**newindex;
+
+	    newindex = vim_realloc(l->lv_index, sizeof(listitem_T *) * newsize);
+	    if (newindex == NULL)
+		list_index_clear(l);
+	    else
+	    {
+		l->lv_index = newindex;
+		l->lv_index_size = newsize;
+	    }
+	}
+	if (l->lv_index != NULL)
+	    l->lv_index[l->lv_len] = item;
+    }
     if (l->lv_u.mat.lv_last == NULL)
     {
 	// empty list
@@ -713,6 +786,7 @@ list_insert(list_T *l, listitem_T *ni, listitem_T *item)
     else
     {
 	// Insert new item before existing item.
+	list_index_clear(l);
 	ni->li_prev = item->li_prev;
 	ni->li_next = item;
 	if (item->li_prev == NULL)
@@ -844,6 +918,10 @@ vimlist_remove(list_T *l, listitem_T *item, listitem_T *item2)
 
     CHECK_LIST_MATERIALIZE(l);
 
+    // The index remains valid when removing items at the end.
+    if (item2->li_next != NULL)
+	list_index_clear(l);
+
     // notify watchers
     for (ip = item; ip != NULL; ip = ip->li_next)
     {
@@ -1648,6 +1726,8 @@ do_sort_uniq(typval_T *argvars, typval_T *rettv, int sort)
 
 	    if (!info.item_compare_func_err)
 	    {
+		if (i > 0)
+		    list_index_clear(l);
 		while (--i >= 0)
 		{
 		    li = ptrs[i].item->li_next;
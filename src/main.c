@@ -491,6 +491,7 @@ vim_main2(void)
 	{
 	    rtp_copy = vim_strsave(p_rtp);
 	    add_pack_start_dirs();
+	    TIME_MSG("adding packages");
 	}
 
 	source_in_path(rtp_copy == NULL ? p_rtp : rtp_copy,
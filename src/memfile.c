@@ -67,12 +67,25 @@ extern int dos2;			// this is in os_amiga.c
 
 #define MEMFILE_PAGE_SIZE 4096		// default page size
 
+/*
+ * Blocks read from the file in increasing order, at most MF_SCAN_GAP pages
+ * apart, are a sequential scan once there are MF_SCAN_MIN of them.  Blocks
+ * read by a scan are put at the end of the used list, so that they are
+ * released first and do not push out blocks that are used repeatedly.  Only
+ * when a block is used again it moves to the front.  The kernel is asked to
+ * read the next MF_READAHEAD pages ahead of the scan.
+ */
+#define MF_SCAN_GAP	8
+#define MF_SCAN_MIN	4
+#define MF_READAHEAD	64
+
 static long_u	total_mem_used = 0;	// total memory used for memfiles
 
 static void mf_ins_hash(memfile_T *, bhdr_T *);
 static void mf_rem_hash(memfile_T *, bhdr_T *);
 static bhdr_T *mf_find_hash(memfile_T *, blocknr_T);
 static void mf_ins_used(memfile_T *, bhdr_T *);
+static void mf_ins_used_last(memfile_T *, bhdr_T *);
 static void mf_rem_used(memfile_T *, bhdr_T *);
 static bhdr_T *mf_release(memfile_T *, int);
 static bhdr_T *mf_alloc_bhdr(memfile_T *, int);
@@ -80,6 +93,7 @@ static void mf_free_bhdr(bhdr_T *);
 static void mf_ins_free(memfile_T *, bhdr_T *);
 static bhdr_T *mf_rem_free(memfile_T *);
 static int  mf_read(memfile_T *, bhdr_T *);
+static int  mf_scan_check(memfile_T *, bhdr_T *);
 static int  mf_write(memfile_T *, bhdr_T *);
 static int  mf_write_block(memfile_T *mfp, bhdr_T *hp, off_T offset, unsigned size);
 static int  mf_trans_add(memfile_T *, bhdr_T *);
@@ -156,6 +170,11 @@ mf_open(char_u *fname, int flags)
     mfp->mf_used_last = NULL;
     mfp->mf_dirty = FALSE;
     mfp->mf_used_count = 0;
+    mfp->mf_scan_next = 0;
+    mfp->mf_scan_count = 0;
+    mfp->mf_readahead = 0;
+    mfp->mf_hit_count = 0;
+    mfp->mf_miss_count = 0;
     mf_hash_init(&mfp->mf_hash);
     mf_hash_init(&mfp->mf_trans);
     mfp->mf_page_size = MEMFILE_PAGE_SIZE;
@@ -446,15 +465,23 @@ mf_get(memfile_T *mfp, blocknr_T nr, int page_count)
 	    mf_free_bhdr(hp);
 	    return NULL;
 	}
+	++mfp->mf_miss_count;
+	if (mf_scan_check(mfp, hp))
+	    hp->bh_flags = BH_SCAN;
     }
     else
     {
+	++mfp->mf_hit_count;
 	mf_rem_used(mfp, hp);	// remove from list, insert in front below
 	mf_rem_hash(mfp, hp);
+	hp->bh_flags &= ~BH_SCAN;   // used again, no longer only scanned
     }
 
     hp->bh_flags |= BH_LOCKED;
-    mf_ins_used(mfp, hp);	// put in front of used list
+    if (hp->bh_flags & BH_SCAN)
+	mf_ins_used_last(mfp, hp);  // release it first
+    else
+	mf_ins_used(mfp, hp);	// put in front of used list
     mf_ins_hash(mfp, hp);	// put in front of hash list
 
     return hp;
@@ -735,6 +762,23 @@ mf_ins_used(memfile_T *mfp, bhdr_T *hp)
     total_mem_used += hp->bh_page_count * mfp->mf_page_size;
 }
 
+/*
+ * insert block *hp at the end of used list of memfile *mfp
+ */
+    static void
+mf_ins_used_last(memfile_T *mfp, bhdr_T *hp)
+{
+    hp->bh_prev = mfp->mf_used_last;
+    mfp->mf_used_last = hp;
+    hp->bh_next = NULL;
+    if (hp->bh_prev == NULL)	    // list was empty, adjust first pointer
+	mfp->mf_used_first = hp;
+    else
+	hp->bh_prev->bh_next = hp;
+    mfp->mf_used_count += hp->bh_page_count;
+    total_mem_used += hp->bh_page_count * mfp->mf_page_size;
+}
+
 /*
  * remove block *hp from used list of memfile *mfp
  */
@@ -978,6 +1022,47 @@ mf_read(memfile_T *mfp, bhdr_T *hp)
     return OK;
 }
 
+/*
+ * Called when block *hp was read from the file.  Return TRUE when it is part
+ * of a sequential scan, then also ask for reading the following pages ahead.
+ */
+    static int
+mf_scan_check(memfile_T *mfp, bhdr_T *hp)
+{
+    blocknr_T	nr = hp->bh_bnum;
+
+    if (nr >= mfp->mf_scan_next && nr < mfp->mf_scan_next + MF_SCAN_GAP)
+	++mfp->mf_scan_count;
+    else
+    {
+	mfp->mf_scan_count = 0;
+	mfp->mf_readahead = 0;
+    }
+    mfp->mf_scan_next = nr + hp->bh_page_count;
+    if (mfp->mf_scan_count < MF_SCAN_MIN)
+	return FALSE;
+
+#ifdef POSIX_FADV_WILLNEED
+    // Ask for the next pages when half of the previous request was used.
+    if (mfp->mf_scan_next + MF_READAHEAD / 2 > mfp->mf_readahead
+	    && mfp->mf_readahead < mfp->mf_infile_count)
+    {
+	blocknr_T   start = mfp->mf_readahead;
+
+	if (start < mfp->mf_scan_next)
+	    start = mfp->mf_scan_next;
+	mfp->mf_readahead = mfp->mf_scan_next + MF_READAHEAD;
+	if (mfp->mf_readahead > mfp->mf_infile_count)
+	    mfp->mf_readahead = mfp->mf_infile_count;
+	if (start < mfp->mf_readahead)
+	    (void)posix_fadvise(mfp->mf_fd, (off_T)mfp->mf_page_size * start,
+			(off_T)mfp->mf_page_size * (mfp->mf_readahead - start),
+							  POSIX_FADV_WILLNEED);
+    }
+#endif
+    return TRUE;
+}
+
 /*
  * write a block to disk
  *
@@ -244,6 +244,8 @@ static void add_b0_fenc(ZERO_BL *b0p, buf_T *buf);
 static time_t swapfile_info(char_u *);
 static int recov_file_names(char_u **, char_u *, int prepend_dot);
 static int ml_delete_int(buf_T *, linenr_T, int);
+static int ml_free_locked_block(buf_T *);
+static long ml_delete_block_lines(buf_T *, linenr_T, long);
 static char_u *findswapname(buf_T *, char_u **, char_u *);
 static void ml_flush_line(buf_T *);
 static bhdr_T *ml_new_data(memfile_T *, int, int);
@@ -261,6 +263,9 @@ static long char_to_long(char_u *);
 static cryptstate_T *ml_crypt_prepare(memfile_T *mfp, off_T offset, int reading);
 #endif
 #ifdef FEAT_BYTEOFF
+static void ml_chunktree_add(buf_T *buf, int idx, int lines, long size);
+static int ml_chunktree_build(buf_T *buf);
+static int ml_find_chunk(buf_T *buf, linenr_T lnum, long offset, int ffdos, linenr_T *linep, long *sizep);
 static void ml_updatechunk(buf_T *buf, long line, long len, int updtype);
 #endif
 
@@ -288,6 +293,9 @@ ml_open(buf_T *buf)
     buf->b_ml.ml_line_lnum = 0;	// no cached line
 #ifdef FEAT_BYTEOFF
     buf->b_ml.ml_chunksize = NULL;
+    buf->b_ml.ml_chunktree = NULL;
+    buf->b_ml.ml_chunktree_len = 0;
+    buf->b_ml.ml_chunktree_valid = FALSE;
 #endif
 
     if (cmdmod.noswapfile)
@@ -847,6 +855,9 @@ ml_close(buf_T *buf, int del_file)
     vim_free(buf->b_ml.ml_stack);
 #ifdef FEAT_BYTEOFF
     VIM_CLEAR(buf->b_ml.ml_chunksize);
+    VIM_CLEAR(buf->b_ml.ml_chunktree);
+    buf->b_ml.ml_chunktree_len = 0;
+    buf->b_ml.ml_chunktree_valid = FALSE;
 #endif
     buf->b_ml.ml_mfp = NULL;
 
@@ -3516,11 +3527,8 @@ ml_delete_int(buf_T *buf, linenr_T lnum, int message)
     bhdr_T	*hp;
     memfile_T	*mfp;
     DATA_BL	*dp;
-    PTR_BL	*pp;
-    infoptr_T	*ip;
     int		count;	    // number of entries in block
     int		idx;
-    int		stack_idx;
     int		text_start;
     int		line_start;
     long	line_size;
@@ -3609,48 +3617,8 @@ ml_delete_int(buf_T *buf, linenr_T lnum, int message)
  */
     if (count == 1)
     {
-	mf_free(mfp, hp);	// free the data block
-	buf->b_ml.ml_locked = NULL;
-
-	for (stack_idx = buf->b_ml.ml_stack_top - 1; stack_idx >= 0;
-								  --stack_idx)
-	{
-	    buf->b_ml.ml_stack_top = 0;	    // stack is invalid when failing
-	    ip = &(buf->b_ml.ml_stack[stack_idx]);
-	    idx = ip->ip_index;
-	    if ((hp = mf_get(mfp, ip->ip_bnum, 1)) == NULL)
-		goto theend;
-	    pp = (PTR_BL *)(hp->bh_data);   // must be pointer block
-	    if (pp->pb_id != PTR_ID)
-	    {
-		iemsg(_("E317: pointer block id wrong 4"));
-		mf_put(mfp, hp, FALSE, FALSE);
-		goto theend;
-	    }
-	    count = --(pp->pb_count);
-	    if (count == 0)	    // the pointer block becomes empty!
-		mf_free(mfp, hp);
-	    else
-	    {
-		if (count != idx)	// move entries after the deleted one
-		    mch_memmove(&pp->pb_pointer[idx], &pp->pb_pointer[idx + 1],
-				      (size_t)(count - idx) * sizeof(PTR_EN));
-		mf_put(mfp, hp, TRUE, FALSE);
-
-		buf->b_ml.ml_stack_top = stack_idx;	// truncate stack
-		// fix line count for rest of blocks in the stack
-		if (buf->b_ml.ml_locked_lineadd != 0)
-		{
-		    ml_lineadd(buf, buf->b_ml.ml_locked_lineadd);
-		    buf->b_ml.ml_stack[buf->b_ml.ml_stack_top].ip_high +=
-						  buf->b_ml.ml_locked_lineadd;
-		}
-		++(buf->b_ml.ml_stack_top);
-
-		break;
-	    }
-	}
-	CHECK(stack_idx < 0, _("deleted block 1?"));
+	if (ml_free_locked_block(buf) == FAIL)
+	    goto theend;
     }
     else
     {
@@ -3698,6 +3666,220 @@ theend:
     return ret;
 }
 
+/*
+ * Free the locked data block, which has become empty, and remove the entry
+ * pointing to it from the pointer block. If this pointer block also becomes
+ * empty, we go up another block, and so on, up to the root if necessary.
+ * The line counts in the pointer blocks have already been adjusted by
+ * ml_find_line(), "ml_locked_lineadd" is applied to the remaining ones.
+ *
+ * return FAIL for failure, OK otherwise
+ */
+    static int
+ml_free_locked_block(buf_T *buf)
+{
+    memfile_T	*mfp = buf->b_ml.ml_mfp;
+    bhdr_T	*hp;
+    PTR_BL	*pp;
+    infoptr_T	*ip;
+    int		count;
+    int		idx;
+    int		stack_idx;
+
+    mf_free(mfp, buf->b_ml.ml_locked);	// free the data block
+    buf->b_ml.ml_locked = NULL;
+
+    for (stack_idx = buf->b_ml.ml_stack_top - 1; stack_idx >= 0; --stack_idx)
+    {
+	buf->b_ml.ml_stack_top = 0;	    // stack is invalid when failing
+	ip = &(buf->b_ml.ml_stack[stack_idx]);
+	idx = ip->ip_index;
+	if ((hp = mf_get(mfp, ip->ip_bnum, 1)) == NULL)
+	    return FAIL;
+	pp = (PTR_BL *)(hp->bh_data);   // must be pointer block
+	if (pp->pb_id != PTR_ID)
+	{
+	    iemsg(_("E317: pointer block id wrong 4"));
+	    mf_put(mfp, hp, FALSE, FALSE);
+	    return FAIL;
+	}
+	count = --(pp->pb_count);
+	if (count == 0)	    // the pointer block becomes empty!
+	    mf_free(mfp, hp);
+	else
+	{
+	    if (count != idx)	// move entries after the deleted one
+		mch_memmove(&pp->pb_pointer[idx], &pp->pb_pointer[idx + 1],
+				      (size_t)(count - idx) * sizeof(PTR_EN));
+	    mf_put(mfp, hp, TRUE, FALSE);
+
+	    buf->b_ml.ml_stack_top = stack_idx;	// truncate stack
+	    // fix line count for rest of blocks in the stack
+	    if (buf->b_ml.ml_locked_lineadd != 0)
+	    {
+		ml_lineadd(buf, buf->b_ml.ml_locked_lineadd);
+		buf->b_ml.ml_stack[buf->b_ml.ml_stack_top].ip_high +=
+						  buf->b_ml.ml_locked_lineadd;
+	    }
+	    ++(buf->b_ml.ml_stack_top);
+
+	    break;
+	}
+    }
+    CHECK(stack_idx < 0, _("deleted block 1?"));
+    return OK;
+}
+
+/*
+ * Delete "count" lines starting at line "lnum" in the current buffer.
+ * Lines that are in the same data block are removed with a single move of
+ * the remaining text, instead of shifting the block contents once for every
+ * line.  A data block that becomes empty is dropped from the tree as a whole.
+ * When "message" is TRUE may give a "No lines in buffer" message.
+ *
+ * Check: The caller of this function should probably also call
+ * deleted_lines() after this.
+ *
+ * return FAIL for failure, OK otherwise
+ */
+    int
+ml_delete_lines(linenr_T lnum, long count, int message)
+{
+    long	done;
+
+    ml_flush_line(curbuf);
+    if (lnum < 1 || count <= 0
+			  || lnum + count - 1 > curbuf->b_ml.ml_line_count)
+	return FAIL;
+
+#ifdef FEAT_EVAL
+    // When inserting above recorded changes: flush the changes before changing
+    // the text.
+    may_invoke_listeners(curbuf, lnum, lnum + count, -count);
+#endif
+
+    while (count > 0)
+    {
+	done = ml_delete_block_lines(curbuf, lnum, count);
+	if (done < 0)
+	    return FAIL;
+	if (done == 0)
+	{
+	    // Cannot do it in bulk, delete a single line.
+	    if (ml_delete_int(curbuf, lnum, message) == FAIL)
+		return FAIL;
+	    done = 1;
+	}
+	count -= done;
+    }
+    return OK;
+}
+
+/*
+ * Delete up to "count" lines starting at "lnum" from the data block that
+ * contains "lnum".  Never deletes the last line in the buffer.
+ * Returns the number of lines deleted, zero when the lines have to be deleted
+ * one by one with ml_delete_int() and -1 for failure.
+ */
+    static long
+ml_delete_block_lines(buf_T *buf, linenr_T lnum, long count)
+{
+    bhdr_T	*hp;
+    DATA_BL	*dp;
+    int		block_count;	// number of entries in block
+    int		idx;
+    int		n;
+    int		i;
+    int		text_start;
+    int		line_start;
+    long	line_size;
+    long	total_size;
+
+    if (count < 2 || buf->b_ml.ml_line_count <= 2 || buf->b_ml.ml_mfp == NULL)
+	return 0;
+#ifdef FEAT_PROP_POPUP
+    // Text properties of the surrounding lines need to be adjusted per line.
+    if (buf->b_has_textprop)
+	return 0;
+#endif
+#ifdef FEAT_NETBEANS_INTG
+    if (netbeans_active())
+	return 0;
+#endif
+
+    if ((hp = ml_find_line(buf, lnum, ML_DELETE)) == NULL)
+	return 0;
+
+    dp = (DATA_BL *)(hp->bh_data);
+    // compute line count before the delete
+    block_count = (long)(buf->b_ml.ml_locked_high)
+					- (long)(buf->b_ml.ml_locked_low) + 2;
+    idx = lnum - buf->b_ml.ml_locked_low;
+
+    n = block_count - idx;
+    if (count < n)
+	n = count;
+    if (buf->b_ml.ml_line_count - 1 < n)
+	n = buf->b_ml.ml_line_count - 1;
+
+    // ml_find_line() accounted for one line, the stack and the pointer blocks
+    // are updated for the others when the block is released.
+    buf->b_ml.ml_locked_lineadd -= n - 1;
+    buf->b_ml.ml_locked_high -= n - 1;
+    buf->b_ml.ml_line_count -= n;
+
+    if (lowest_marked && lowest_marked > lnum)
+	lowest_marked = lowest_marked - n > lnum ? lowest_marked - n : lnum;
+
+    total_size = 0;
+    for (i = idx; i < idx + n; ++i)
+    {
+	line_start = ((dp->db_index[i]) & DB_INDEX_MASK);
+	if (i == 0)		// first line in block, text at the end
+	    line_size = dp->db_txt_end - line_start;
+	else
+	    line_size = ((dp->db_index[i - 1]) & DB_INDEX_MASK) - line_start;
+	total_size += line_size;
+#ifdef FEAT_BYTEOFF
+	ml_updatechunk(buf, lnum, line_size, ML_CHNK_DELLINE);
+#endif
+    }
+
+    if (n == block_count)
+    {
+	if (ml_free_locked_block(buf) == FAIL)
+	    return -1;
+    }
+    else
+    {
+	/*
+	 * delete the text by moving the next lines forwards, all at once
+	 */
+	text_start = dp->db_txt_start;
+	line_start = ((dp->db_index[idx + n - 1]) & DB_INDEX_MASK);
+	mch_memmove((char *)dp + text_start + total_size,
+		  (char *)dp + text_start, (size_t)(line_start - text_start));
+
+	/*
+	 * delete the indexes by moving the next indexes backwards
+	 * Adjust the indexes for the text movement.
+	 */
+	for (i = idx; i < block_count - n; ++i)
+	    dp->db_index[i] = dp->db_index[i + n] + total_size;
+
+	dp->db_free += total_size + n * INDEX_SIZE;
+	dp->db_txt_start += total_size;
+	dp->db_line_count -= n;
+
+	/*
+	 * mark the block dirty and make sure it is in the file (for recovery)
+	 */
+	buf->b_ml.ml_flags |= (ML_LOCKED_DIRTY | ML_LOCKED_POS);
+    }
+
+    return n;
+}
+
 /*
  * set the DB_MARKED flag for line 'lnum'
  */
@@ -5328,6 +5510,137 @@ ml_crypt_prepare(memfile_T *mfp, off_T offset, int reading)
 #define MLCS_MAXL 800	// max no of lines in chunk
 #define MLCS_MINL 400   // should be half of MLCS_MAXL
 
+/*
+ * The chunks are also kept in a Fenwick tree (binary indexed tree), so that
+ * the chunk containing a line or a byte offset can be found in O(log n)
+ * instead of adding up all the chunks before it.  Entry "i" of the tree
+ * holds the sums for chunks "i - (i & -i)" to "i - 1".
+ * Changing the size of a chunk updates the tree, inserting or removing a
+ * chunk marks it invalid and it is rebuilt when it is used next.
+ */
+    static void
+ml_chunktree_add(buf_T *buf, int idx, int lines, long size)
+{
+    chunksize_T	*tree = buf->b_ml.ml_chunktree;
+    int		i;
+
+    if (!buf->b_ml.ml_chunktree_valid)
+	return;
+    for (i = idx + 1; i <= buf->b_ml.ml_usedchunks; i += i & -i)
+    {
+	tree[i].mlcs_numlines += lines;
+	tree[i].mlcs_totalsize += size;
+    }
+}
+
+/*
+ * Rebuild the Fenwick tree from the chunks, in O(n).
+ * Returns FAIL when out of memory.
+ */
+    static int
+ml_chunktree_build(buf_T *buf)
+{
+    chunksize_T	*tree;
+    int		used = buf->b_ml.ml_usedchunks;
+    int		i, j;
+
+    if (buf->b_ml.ml_chunktree_len < used + 1)
+    {
+	vim_free(buf->b_ml.ml_chunktree);
+	buf->b_ml.ml_chunktree_len = 0;
+	buf->b_ml.ml_chunktree = ALLOC_MULT(chunksize_T,
+						  buf->b_ml.ml_numchunks + 1);
+	if (buf->b_ml.ml_chunktree == NULL)
+	    return FAIL;
+	buf->b_ml.ml_chunktree_len = buf->b_ml.ml_numchunks + 1;
+    }
+    tree = buf->b_ml.ml_chunktree;
+    for (i = 1; i <= used; ++i)
+	tree[i] = buf->b_ml.ml_chunksize[i - 1];
+    for (i = 1; i <= used; ++i)
+    {
+	j = i + (i & -i);
+	if (j <= used)
+	{
+	    tree[j].mlcs_numlines += tree[i].mlcs_numlines;
+	    tree[j].mlcs_totalsize += tree[i].mlcs_totalsize;
+	}
+    }
+    buf->b_ml.ml_chunktree_valid = TRUE;
+    return OK;
+}
+
+/*
+ * Find the chunk containing line "lnum" (when not zero) or byte "offset"
+ * (when not zero), never going past the last chunk.  When "ffdos" is TRUE
+ * one byte is counted for the CR of every line when looking for "offset".
+ * Sets "*linep" to the first line of the chunk and "*sizep" to the number of
+ * bytes before it, including the CRs when looking for "offset".
+ * Returns the index of the chunk.
+ */
+    static int
+ml_find_chunk(
+    buf_T	*buf,
+    linenr_T	lnum,
+    long	offset,
+    int		ffdos,
+    linenr_T	*linep,
+    long	*sizep)
+{
+    chunksize_T	*chunks = buf->b_ml.ml_chunksize;
+    int		last = buf->b_ml.ml_usedchunks - 1;
+    linenr_T	lines = 0;
+    long	size = 0;
+    int		curix = 0;
+
+    if (buf->b_ml.ml_chunktree_valid || ml_chunktree_build(buf) == OK)
+    {
+	chunksize_T *tree = buf->b_ml.ml_chunktree;
+	int	    bit;
+	int	    next;
+	linenr_T    nl;
+	long	    ns;
+
+	for (bit = 1; bit * 2 <= last; bit *= 2)
+	    ;
+	for ( ; bit > 0; bit /= 2)
+	{
+	    next = curix + bit;
+	    if (next > last)
+		continue;
+	    nl = lines + tree[next].mlcs_numlines;
+	    ns = size + tree[next].mlcs_totalsize;
+	    if ((lnum != 0 && lnum > nl)
+			   || (offset != 0 && offset > ns + ffdos * (long)nl))
+	    {
+		curix = next;
+		lines = nl;
+		size = ns;
+	    }
+	}
+    }
+    else
+    {
+	// Out of memory, walk the chunks.
+	while (curix < last
+		&& ((lnum != 0 && lnum > lines + chunks[curix].mlcs_numlines)
+		    || (offset != 0
+			&& offset > size + chunks[curix].mlcs_totalsize
+			  + ffdos * (long)(lines + chunks[curix].mlcs_numlines))))
+	{
+	    lines += chunks[curix].mlcs_numlines;
+	    size += chunks[curix].mlcs_totalsize;
+	    ++curix;
+	}
+    }
+
+    *linep = lines + 1;
+    *sizep = size;
+    if (offset != 0 && ffdos)
+	*sizep += lines;
+    return curix;
+}
+
 /*
  * Keep information for finding byte offset of a line, updtype may be one of:
  * ML_CHNK_ADDLINE: Add len to parent chunk, possibly splitting it
@@ -5350,6 +5663,7 @@ ml_updatechunk(
     linenr_T		curline = ml_upd_lastcurline;
     int			curix = ml_upd_lastcurix;
     long		size;
+    long		before;
     chunksize_T		*curchnk;
     int			rest;
     bhdr_T		*hp;
@@ -5369,6 +5683,7 @@ ml_updatechunk(
 	buf->b_ml.ml_usedchunks = 1;
 	buf->b_ml.ml_chunksize[0].mlcs_numlines = 1;
 	buf->b_ml.ml_chunksize[0].mlcs_totalsize = 1;
+	buf->b_ml.ml_chunktree_valid = FALSE;
     }
 
     if (updtype == ML_CHNK_UPDLINE && buf->b_ml.ml_line_count == 1)
@@ -5379,6 +5694,7 @@ ml_updatechunk(
 	buf->b_ml.ml_usedchunks = 1;
 	buf->b_ml.ml_chunksize[0].mlcs_numlines = 1;
 	buf->b_ml.ml_chunksize[0].mlcs_totalsize = (long)buf->b_ml.ml_line_len;
+	buf->b_ml.ml_chunktree_valid = FALSE;
 	return;
     }
 
@@ -5388,13 +5704,7 @@ ml_updatechunk(
      */
     if (buf != ml_upd_lastbuf || line != ml_upd_lastline + 1
 	    || updtype != ML_CHNK_ADDLINE)
-    {
-	for (curline = 1, curix = 0;
-	     curix < buf->b_ml.ml_usedchunks - 1
-	     && line >= curline + buf->b_ml.ml_chunksize[curix].mlcs_numlines;
-	     curix++)
-	    curline += buf->b_ml.ml_chunksize[curix].mlcs_numlines;
-    }
+	curix = ml_find_chunk(buf, line, 0L, FALSE, &curline, &before);
     else if (curix < buf->b_ml.ml_usedchunks - 1
 	      && line >= curline + buf->b_ml.ml_chunksize[curix].mlcs_numlines)
     {
@@ -5407,6 +5717,8 @@ ml_updatechunk(
     if (updtype == ML_CHNK_DELLINE)
 	len = -len;
     curchnk->mlcs_totalsize += len;
+    ml_chunktree_add(buf, curix, updtype == ML_CHNK_ADDLINE ? 1
+			      : updtype == ML_CHNK_DELLINE ? -1 : 0, len);
     if (updtype == ML_CHNK_ADDLINE)
     {
 	curchnk->mlcs_numlines++;
@@ -5437,6 +5749,7 @@ ml_updatechunk(
 	    int	    text_end;
 	    int	    linecnt;
 
+	    buf->b_ml.ml_chunktree_valid = FALSE;
 	    mch_memmove(buf->b_ml.ml_chunksize + curix + 1,
 			buf->b_ml.ml_chunksize + curix,
 			(buf->b_ml.ml_usedchunks - curix) *
@@ -5509,6 +5822,7 @@ ml_updatechunk(
 	     */
 	    curchnk = buf->b_ml.ml_chunksize + curix + 1;
 	    buf->b_ml.ml_usedchunks++;
+	    buf->b_ml.ml_chunktree_valid = FALSE;
 	    if (line == buf->b_ml.ml_line_count)
 	    {
 		curchnk->mlcs_numlines = 0;
@@ -5554,6 +5868,7 @@ ml_updatechunk(
 	else if (curix == 0 && curchnk->mlcs_numlines <= 0)
 	{
 	    buf->b_ml.ml_usedchunks--;
+	    buf->b_ml.ml_chunktree_valid = FALSE;
 	    mch_memmove(buf->b_ml.ml_chunksize, buf->b_ml.ml_chunksize + 1,
 			buf->b_ml.ml_usedchunks * sizeof(chunksize_T));
 	    return;
@@ -5569,6 +5884,7 @@ ml_updatechunk(
 	curchnk[-1].mlcs_numlines += curchnk->mlcs_numlines;
 	curchnk[-1].mlcs_totalsize += curchnk->mlcs_totalsize;
 	buf->b_ml.ml_usedchunks--;
+	buf->b_ml.ml_chunktree_valid = FALSE;
 	if (curix < buf->b_ml.ml_usedchunks)
 	{
 	    mch_memmove(buf->b_ml.ml_chunksize + curix,
@@ -5594,7 +5910,6 @@ ml_updatechunk(
 ml_find_line_or_offset(buf_T *buf, linenr_T lnum, long *offp)
 {
     linenr_T	curline;
-    int		curix;
     long	size;
     bhdr_T	*hp;
     DATA_BL	*dp;
@@ -5622,24 +5937,10 @@ ml_find_line_or_offset(buf_T *buf, linenr_T lnum, long *offp)
     if (lnum == 0 && offset <= 0)
 	return 1;   // Not a "find offset" and offset 0 _must_ be in line 1
     /*
-     * Find the last chunk before the one containing our line. Last chunk is
-     * special because it will never qualify
+     * Find the chunk containing our line. Last chunk is special because it
+     * will never qualify
      */
-    curline = 1;
-    curix = size = 0;
-    while (curix < buf->b_ml.ml_usedchunks - 1
-	    && ((lnum != 0
-	     && lnum >= curline + buf->b_ml.ml_chunksize[curix].mlcs_numlines)
-		|| (offset != 0
-	       && offset > size + buf->b_ml.ml_chunksize[curix].mlcs_totalsize
-		      + ffdos * buf->b_ml.ml_chunksize[curix].mlcs_numlines)))
-    {
-	curline += buf->b_ml.ml_chunksize[curix].mlcs_numlines;
-	size += buf->b_ml.ml_chunksize[curix].mlcs_totalsize;
-	if (offset && ffdos)
-	    size += buf->b_ml.ml_chunksize[curix].mlcs_numlines;
-	curix++;
-    }
+    ml_find_chunk(buf, lnum, offset, ffdos, &curline, &size);
 
     while ((lnum != 0 && curline < lnum) || (offset != 0 && size < offset))
     {
@@ -1111,6 +1111,9 @@ free_all_mem(void)
 # if defined(FEAT_SEARCHPATH)
     free_findfile();
 # endif
+# if defined(TEMPDIRNAMES) || defined(FEAT_EVAL)
+    free_rtp_index();
+# endif
 
     // Obviously named calls.
     free_all_autocmds();
@@ -1248,6 +1251,7 @@ free_all_mem(void)
 
     // screenlines (can't display anything now!)
     free_screenlines();
+    free_out_buf();
 
 # if defined(FEAT_SOUND)
     sound_free();
@@ -2164,6 +2168,21 @@ ga_concat(garray_T *gap, char_u *s)
     }
 }
 
+/*
+ * Concatenate "len" bytes at "s" to a growarray which contains bytes.
+ */
+    void
+ga_concat_len(garray_T *gap, char_u *s, size_t len)
+{
+    if (s == NULL || len == 0)
+	return;
+    if (ga_grow(gap, (int)len) == OK)
+    {
+	mch_memmove((char *)gap->ga_data + gap->ga_len, s, len);
+	gap->ga_len += (int)len;
+    }
+}
+
 /*
  * Append one byte to a growarray which contains bytes.
  */
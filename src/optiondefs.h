@@ -3009,6 +3009,7 @@ static struct vimoption options[] =
     p_term("t_bc", T_BC)
     p_term("t_BE", T_BE)
     p_term("t_BD", T_BD)
+    p_term("t_BS", T_BSU)
     p_term("t_cd", T_CD)
     p_term("t_ce", T_CE)
     p_term("t_cl", T_CL)
@@ -3025,6 +3026,7 @@ static struct vimoption options[] =
     p_term("t_dl", T_DL)
     p_term("t_EC", T_CEC)
     p_term("t_EI", T_CEI)
+    p_term("t_ES", T_ESU)
     p_term("t_fs", T_FS)
     p_term("t_GP", T_CGP)
     p_term("t_IE", T_CIE)
@@ -352,7 +352,19 @@ mch_chdir(char *path)
     void
 mch_write(char_u *s, int len)
 {
-    vim_ignored = (int)write(1, (char *)s, len);
+    int	    n;
+
+    // A big write may be interrupted by a signal or be done partly.
+    while (len > 0)
+    {
+	n = (int)write(1, (char *)s, len);
+	if (n < 0 && errno == EINTR)
+	    continue;
+	if (n <= 0)
+	    break;
+	s += n;
+	len -= n;
+    }
     if (p_wd)		// Unix is too fast, slow down a bit more
 	RealWaitForChar(read_cmd_fd, p_wd, NULL, NULL);
 }
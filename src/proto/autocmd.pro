@@ -31,6 +31,7 @@ void unblock_autocmds(void);
 int is_autocmd_blocked(void);
 char_u *getnextac(int c, void *cookie, int indent, int do_concat);
 int has_autocmd(event_T event, char_u *sfname, buf_T *buf);
+int has_autocmd_skip_group(event_T event, char_u *sfname, buf_T *buf, char_u *skip_group);
 char_u *get_augroup_name(expand_T *xp, int idx);
 char_u *set_context_in_autocmd(expand_T *xp, char_u *arg, int doautocmd);
 char_u *get_event_name(expand_T *xp, int idx);
@@ -13,6 +13,9 @@ list_T *reg_submatch_list(int no);
 int vim_regcomp_had_eol(void);
 regprog_T *vim_regcomp(char_u *expr_arg, int re_flags);
 void vim_regfree(regprog_T *prog);
+regprog_T *vim_regcomp_reuse(char_u *expr, int re_flags);
+void vim_regfree_reuse(regprog_T *prog, char_u *expr, int re_flags);
+char_u *vim_regmust(regprog_T *prog, int *icp);
 void free_regexp_stuff(void);
 int regprog_in_use(regprog_T *prog);
 int vim_regexec_prog(regprog_T **prog, int ignore_case, char_u *line, colnr_T col);
@@ -6,6 +6,7 @@ int estack_top_is_ufunc(ufunc_T *ufunc, long lnum);
 void estack_pop(void);
 char_u *estack_sfile(void);
 void ex_runtime(exarg_T *eap);
+void free_rtp_index(void);
 int do_in_path(char_u *path, char_u *name, int flags, void (*callback)(char_u *fname, void *ck), void *cookie);
 int do_in_runtimepath(char_u *name, int flags, void (*callback)(char_u *fname, void *ck), void *cookie);
 int source_runtime(char_u *name, int flags);
@@ -9,7 +9,9 @@ int term_is_8bit(char_u *name);
 int term_is_gui(char_u *name);
 char_u *tltoa(unsigned long i);
 void termcapinit(char_u *name);
+void out_frame_start(void);
 void out_flush(void);
+void free_out_buf(void);
 void out_flush_cursor(int force, int clear_selection);
 void out_flush_check(void);
 void out_trash(void);
@@ -1,4 +1,5 @@
 /* vim9execute.c */
+varnumber_T number_op(exptype_T type, varnumber_T arg1, varnumber_T arg2);
 int call_def_function(ufunc_T *ufunc, int argc_arg, typval_T *argv, partial_T *partial, typval_T *rettv);
 void ex_disassemble(exarg_T *eap);
 int tv2bool(typval_T *tv);
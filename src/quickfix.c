@@ -5769,6 +5769,186 @@ vgr_match_buflines(
     return found_match;
 }
 
+/*
+ * Get a literal string that must appear in the file bytes for a file to
+ * contain a match for "regmatch".  Sets "*icp" when case is to be ignored.
+ * Returns NULL when there is no such string or reading a file may change the
+ * bytes of the string.  The returned string must be freed.
+ */
+    static char_u *
+vgr_get_literal(regmmatch_T *regmatch, int *icp)
+{
+    int		ic = regmatch->rmm_ic;
+    char_u	*must = vim_regmust(regmatch->regprog, &ic);
+    char_u	*p;
+    char_u	*start;
+    char_u	*best = NULL;
+    int		bestlen = 0;
+    char_u	*fenc;
+    char_u	buf[50];
+    int		props;
+
+    if (must == NULL)
+	return NULL;
+
+    // Each encoding in 'fileencodings' must keep ASCII text unchanged.
+    for (p = p_fencs; *p != NUL; )
+    {
+	copy_option_part(&p, buf, sizeof(buf), ",");
+	if (STRCMP(buf, "ucs-bom") == 0)
+	    continue;
+	fenc = enc_canonize(buf);
+	if (fenc == NULL)
+	    return NULL;
+	props = enc_canon_props(fenc);
+	if (!(props & (ENC_8BIT | ENC_DBCS)) && STRCMP(fenc, "utf-8") != 0)
+	{
+	    vim_free(fenc);
+	    return NULL;
+	}
+	vim_free(fenc);
+    }
+
+    // Use the longest part of the string with only ASCII characters that
+    // are unchanged when reading a file.  When ignoring case, "i", "k" and
+    // "s" may also match a non-ASCII character, skip those.
+    for (p = must; ; ++p)
+    {
+	start = p;
+	while (*p != NUL && *p < 0x80 && *p != NL && *p != CAR
+		&& !(ic && enc_utf8
+			     && vim_strchr((char_u *)"iIkKsS", *p) != NULL))
+	    ++p;
+	if (p - start > bestlen)
+	{
+	    best = start;
+	    bestlen = (int)(p - start);
+	}
+	if (*p == NUL)
+	    break;
+    }
+    if (best == NULL)
+	return NULL;
+
+    *icp = ic;
+    return vim_strnsave(best, bestlen);
+}
+
+/*
+ * Return TRUE if "p[len]" contains the string "lit" of "litlen" bytes.
+ */
+    static int
+vgr_find_literal(char_u *p, long len, char_u *lit, int litlen, int ic)
+{
+    char_u	*end = p + len - litlen;
+    int		i;
+
+    for ( ; p <= end; ++p)
+    {
+	if (!ic)
+	{
+	    p = memchr(p, *lit, (size_t)(end - p + 1));
+	    if (p == NULL)
+		return FALSE;
+	    if (memcmp(p, lit, (size_t)litlen) == 0)
+		return TRUE;
+	}
+	else if (TOLOWER_ASC(*p) == TOLOWER_ASC(*lit))
+	{
+	    for (i = 1; i < litlen; ++i)
+		if (TOLOWER_ASC(p[i]) != TOLOWER_ASC(lit[i]))
+		    break;
+	    if (i == litlen)
+		return TRUE;
+	}
+    }
+    return FALSE;
+}
+
+/*
+ * Check if file "fname" may contain a match, using the string "lit" that
+ * every match must contain, without loading the file into a buffer.
+ * Returns FALSE only when the file can be skipped: reading it into a buffer
+ * would not trigger autocommands that may change the text, it is not
+ * encrypted or starting with a UTF-16 or UCS-4 byte order mark and "lit"
+ * does not appear in it.
+ */
+    static int
+vgr_file_may_match(char_u *fname, char_u *lit, int ic)
+{
+    int		fd;
+    char_u	*buffer;
+    int		litlen = (int)STRLEN(lit);
+    long	bufsize = 0x10000L;
+    long	len = 0;
+    long	n;
+    int		first = TRUE;
+    int		retval = FALSE;
+
+    // Autocommands in the "filetypedetect" group only set 'filetype', the
+    // FileType event is not triggered for a dummy buffer.
+    if (has_autocmd_skip_group(EVENT_BUFREADCMD, fname, NULL,
+						  (char_u *)"filetypedetect")
+	    || has_autocmd_skip_group(EVENT_BUFREADPRE, fname, NULL,
+						  (char_u *)"filetypedetect")
+	    || has_autocmd_skip_group(EVENT_BUFREADPOST, fname, NULL,
+						  (char_u *)"filetypedetect"))
+	return TRUE;
+
+    if (mch_isdir(fname))
+	return TRUE;
+    fd = mch_open((char *)fname, O_RDONLY | O_EXTRA, 0);
+    if (fd < 0)
+	return TRUE;
+    buffer = alloc(bufsize + litlen);
+    if (buffer == NULL)
+    {
+	close(fd);
+	return TRUE;
+    }
+
+    while ((n = read_eintr(fd, buffer + len, bufsize)) != 0)
+    {
+	if (n < 0)
+	{
+	    retval = TRUE;
+	    break;
+	}
+	len += n;
+	if (first)
+	{
+	    first = FALSE;
+	    if ((len >= 9 && STRNCMP(buffer, "VimCrypt~", 9) == 0)
+		    || (len >= 2 && ((buffer[0] == 0xfe && buffer[1] == 0xff)
+				|| (buffer[0] == 0xff && buffer[1] == 0xfe)))
+		    || (len >= 4 && buffer[0] == 0 && buffer[1] == 0
+				&& buffer[2] == 0xfe && buffer[3] == 0xff))
+	    {
+		retval = TRUE;
+		break;
+	    }
+	}
+	if (vgr_find_literal(buffer, len, lit, litlen, ic))
+	{
+	    retval = TRUE;
+	    break;
+	}
+	// Keep the tail, the string may continue in the next read.
+	if (len >= litlen)
+	{
+	    mch_memmove(buffer, buffer + len - (litlen - 1), litlen - 1);
+	    len = litlen - 1;
+	}
+	ui_breakcheck();
+	if (got_int)
+	    break;
+    }
+
+    vim_free(buffer);
+    close(fd);
+    return retval;
+}
+
 /*
  * Jump to the first match and update the directory.
  */
@@ -5893,6 +6073,11 @@ vgr_process_files(
     char_u	*dirname_now = NULL;
     int		found_match;
     aco_save_T	aco;
+    char_u	*literal;
+    int		literal_ic = FALSE;
+
+    // A string that every match contains, to skip files without it.
+    literal = vgr_get_literal(&cmd_args->regmatch, &literal_ic);
 
     dirname_start = alloc_id(MAXPATHL, aid_qf_dirname_start);
     dirname_now = alloc_id(MAXPATHL, aid_qf_dirname_now);
@@ -5917,6 +6102,10 @@ vgr_process_files(
 	}
 
 	buf = buflist_findname_exp(cmd_args->fnames[fi]);
+	if ((buf == NULL || buf->b_ml.ml_mfp == NULL) && literal != NULL
+			  && !vgr_file_may_match(fname, literal, literal_ic))
+	    // The file cannot contain a match, don't load it.
+	    continue;
 	if (buf == NULL || buf->b_ml.ml_mfp == NULL)
 	{
 	    // Remember that a buffer with this name already exists.
@@ -6018,6 +6207,7 @@ vgr_process_files(
     status = OK;
 
 theend:
+    vim_free(literal);
     vim_free(dirname_now);
     vim_free(dirname_start);
     return status;
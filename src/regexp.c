@@ -379,6 +379,7 @@ static int	coll_get_char(void);
 static int	prog_magic_wrong(void);
 static int	cstrncmp(char_u *s1, char_u *s2, int *n);
 static char_u	*cstrchr(char_u *, int);
+static int	cstrmust(char_u *s, char_u *must, int *n);
 static int	re_mult_next(char *what);
 static int	reg_iswordc(int);
 
@@ -1683,6 +1684,104 @@ cstrchr(char_u *s, int c)
     return NULL;
 }
 
+/*
+ * Return TRUE if "c1" and "c2" are equal when ignoring case, for utf-8.
+ * The backtracking engine compares folded characters, the NFA engine
+ * compares lower case characters.  These differ, e.g. "İ" lowers to "i" but
+ * does not fold to it.  Accept both, so that no engine misses a match.
+ */
+    static int
+utf_must_char_equal(int c1, int c2)
+{
+    if (c1 == c2 || utf_fold(c1) == utf_fold(c2))
+	return TRUE;
+    return MB_TOLOWER(c1) == MB_TOLOWER(c2);
+}
+
+/*
+ * Return TRUE if "s" starts with "must", ignoring case, for utf-8.
+ * Composing characters are skipped.
+ */
+    static int
+utf_must_equal(char_u *s, char_u *must)
+{
+    char_u	*p = s;
+    char_u	*m = must;
+
+    while (*m != NUL)
+    {
+	int	c;
+
+	if (*p == NUL)
+	    return FALSE;
+	c = mb_ptr2char_adv(&p);
+	if (!utf_must_char_equal(c, mb_ptr2char_adv(&m)))
+	    return FALSE;
+    }
+    return TRUE;
+}
+
+/*
+ * Return TRUE if "s" contains the "must appear" string "must" of "*n" bytes.
+ * Ignores case if rex.reg_ic set.  Used a lot to skip lines without a match,
+ * esp. for ":global", keep it fast!
+ */
+    static int
+cstrmust(char_u *s, char_u *must, int *n)
+{
+    int		c;
+
+    // Without ignoring case the bytes must be equal, the C library strstr()
+    // is a lot faster than checking each character.
+    if (!rex.reg_ic && !rex.reg_icombine)
+	return strstr((char *)s, (char *)must) != NULL;
+
+    if (enc_utf8 && rex.reg_ic)
+    {
+	int	fc, lc;
+
+	// cstrchr() and cstrncmp() use folded case, which misses lines the
+	// NFA engine matches.  Check the first character with both rules.
+	c = utf_ptr2char(must);
+	fc = utf_fold(c);
+	lc = MB_TOLOWER(c);
+	for ( ; *s != NUL; MB_PTR_ADV(s))
+	{
+	    int	sc = *s < 0x80 ? *s : utf_ptr2char(s);
+
+	    // For two ASCII characters comparing folded case is sufficient.
+	    if ((sc == c || utf_fold(sc) == fc
+			  || ((sc >= 0x80 || c >= 0x80) && MB_TOLOWER(sc) == lc))
+		    && (utf_must_equal(s, must)
+			|| (rex.reg_icombine && cstrncmp(s, must, n) == 0)))
+		return TRUE;
+	}
+	return FALSE;
+    }
+
+    if (has_mbyte)
+	c = (*mb_ptr2char)(must);
+    else
+	c = *must;
+
+    // Use two versions of the loop to avoid overhead of conditions.
+    if (!rex.reg_ic || (!enc_utf8 && mb_char2len(c) > 1))
+	while ((s = vim_strchr(s, c)) != NULL)
+	{
+	    if (cstrncmp(s, must, n) == 0)
+		return TRUE;
+	    MB_PTR_ADV(s);
+	}
+    else
+	while ((s = cstrchr(s, c)) != NULL)
+	{
+	    if (cstrncmp(s, must, n) == 0)
+		return TRUE;
+	    MB_PTR_ADV(s);
+	}
+    return FALSE;
+}
+
 ////////////////////////////////////////////////////////////////
 //		      regsub stuff			      //
 ////////////////////////////////////////////////////////////////
@@ -2710,6 +2809,101 @@ vim_regfree(regprog_T *prog)
 	prog->engine->regfree(prog);
 }
 
+#if defined(FEAT_EVAL) || defined(PROTO)
+/*
+ * Functions like "filter(list, 'v:val =~ pat')" compile the same pattern for
+ * every item, which takes several allocations each time.  Therefore the last
+ * program passed to vim_regfree_reuse() is kept, so that vim_regcomp_reuse()
+ * can return it for the same pattern.
+ */
+static regprog_T    *reuse_prog = NULL;
+static char_u	    *reuse_pat = NULL;	// pattern "reuse_prog" was compiled from
+static int	    reuse_flags;	// "re_flags" used for "reuse_prog"
+static int	    reuse_state;	// reuse_get_state() for "reuse_prog"
+
+/*
+ * Return a number for the state that compiling a pattern depends on, other
+ * than the pattern itself and "re_flags".
+ */
+    static int
+reuse_get_state(void)
+{
+    get_cpo_flags();
+    return (int)p_re + (reg_cpo_lit << 2) + (reg_cpo_bsl << 3)
+					  + (has_mbyte << 4) + (enc_utf8 << 5);
+}
+
+/*
+ * Like vim_regcomp(), but return the program passed to vim_regfree_reuse()
+ * if it was compiled from the same pattern.  The program must be freed with
+ * vim_regfree_reuse() or vim_regfree().
+ */
+    regprog_T *
+vim_regcomp_reuse(char_u *expr, int re_flags)
+{
+    if (reuse_prog != NULL && reuse_flags == re_flags
+	    && STRCMP(reuse_pat, expr) == 0
+	    && reuse_state == reuse_get_state())
+    {
+	regprog_T *prog = reuse_prog;
+
+	// Taken out, a nested call compiles the pattern again.
+	reuse_prog = NULL;
+	return prog;
+    }
+    return vim_regcomp(expr, re_flags);
+}
+
+/*
+ * Free "prog", compiled from "expr" with vim_regcomp_reuse() and "re_flags",
+ * or keep it for the next vim_regcomp_reuse() call.
+ * A character class such as "[:keyword:]" depends on the current buffer and
+ * "~" on the previous substitute string, don't keep a program using one.
+ */
+    void
+vim_regfree_reuse(regprog_T *prog, char_u *expr, int re_flags)
+{
+    char_u *pat;
+
+    if (prog == NULL)
+	return;
+    if (strstr((char *)expr, "[:") != NULL || vim_strchr(expr, '~') != NULL
+				       || (pat = vim_strsave(expr)) == NULL)
+    {
+	vim_regfree(prog);
+	return;
+    }
+    vim_regfree(reuse_prog);
+    vim_free(reuse_pat);
+    reuse_prog = prog;
+    reuse_pat = pat;
+    reuse_flags = re_flags;
+    reuse_state = reuse_get_state();
+}
+#endif
+
+/*
+ * Return a string that every match of "prog" must contain, or NULL when that
+ * is not known.  The string is owned by "prog".
+ * "*icp" is the 'ignorecase' value to use, it is updated for "\c" and "\C".
+ * Returns NULL when combining characters are ignored.
+ */
+    char_u *
+vim_regmust(regprog_T *prog, int *icp)
+{
+    if (prog == NULL || (prog->regflags & RF_ICOMBINE))
+	return NULL;
+    if (prog->regflags & RF_ICASE)
+	*icp = TRUE;
+    else if (prog->regflags & RF_NOICASE)
+	*icp = FALSE;
+    if (prog->engine == &bt_regengine)
+	return ((bt_regprog_T *)prog)->regmust;
+    if (prog->engine == &nfa_regengine)
+	return ((nfa_regprog_T *)prog)->regmust;
+    return NULL;
+}
+
 #if defined(EXITFREE) || defined(PROTO)
     void
 free_regexp_stuff(void)
@@ -2718,6 +2912,10 @@ free_regexp_stuff(void)
     ga_clear(&backpos);
     vim_free(reg_tofree);
     vim_free(reg_prev_sub);
+# ifdef FEAT_EVAL
+    vim_regfree(reuse_prog);
+    vim_free(reuse_pat);
+# endif
 }
 #endif
 
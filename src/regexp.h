@@ -94,6 +94,9 @@ struct nfa_state
     int			val;
 };
 
+// DFA built from the NFA, defined in regexp_nfa.c.
+typedef struct nfa_dfa_S nfa_dfa_T;
+
 /*
  * Structure used by the NFA matcher.
  */
@@ -111,6 +114,12 @@ typedef struct
     int			reganch;	// pattern starts with ^
     int			regstart;	// char at start of pattern
     char_u		*match_text;	// plain text to match with
+    char_u		*regmust;	// text that every match contains
+    int			regmlen;	// length of "regmust"
+
+    nfa_dfa_T		*dfa;		// DFA cache, NULL when not used yet
+    int			nexec;		// times executed, up to when the DFA
+					// is used
 
     int			has_zend;	// pattern contains \ze
     int			has_backref;	// pattern contains \1 .. \9
@@ -54,12 +54,10 @@
  *
  * Regstart and reganch permit very fast decisions on suitable starting points
  * for a match, cutting down the work a lot.  Regmust permits fast rejection
- * of lines that cannot possibly match.  The regmust tests are costly enough
- * that vim_regcomp() supplies a regmust only if the r.e. contains something
- * potentially expensive (at present, the only such thing detected is * or +
- * at the start of the r.e., which can involve a lot of backup).  Regmlen is
- * supplied because the test in vim_regexec() needs it and vim_regcomp() is
- * computing it anyway.
+ * of lines that cannot possibly match.  vim_regcomp() supplies a regmust
+ * when the r.e. has one top-level choice and cannot match a line break.
+ * Regmlen is supplied because the test in vim_regexec() needs it and
+ * vim_regcomp() is computing it anyway.
  */
 
 /*
@@ -2368,17 +2366,15 @@ bt_regcomp(char_u *expr, int re_flags)
 		r->regstart = *OPERAND(regnext(scan));
 	}
 
-	// If there's something expensive in the r.e., find the longest
-	// literal string that must appear and make it the regmust.  Resolve
-	// ties in favor of later strings, since the regstart check works
-	// with the beginning of the r.e. and avoiding duplication
-	// strengthens checking.  Not a strong reason, but sufficient in the
-	// absence of others.
-
-	// When the r.e. starts with BOW, it is faster to look for a regmust
-	// first. Used a lot for "#" and "*" commands. (Added by mool).
-	if ((flags & SPSTART || OP(scan) == BOW || OP(scan) == EOW)
-							  && !(flags & HASNL))
+	// Find the longest literal string that must appear and make it the
+	// regmust.  Resolve ties in favor of later strings, since the
+	// regstart check works with the beginning of the r.e. and avoiding
+	// duplication strengthens checking.  Not a strong reason, but
+	// sufficient in the absence of others.
+	// Checking for the regmust is cheap, lines without it are skipped
+	// before trying a match at every position.  Not possible when the
+	// match may continue in the next line.
+	if (!(flags & HASNL))
 	{
 	    longest = NULL;
 	    len = 0;
@@ -4671,43 +4667,11 @@ bt_regexec_both(
     if (prog->regflags & RF_ICOMBINE)
 	rex.reg_icombine = TRUE;
 
-    // If there is a "must appear" string, look for it.
-    if (prog->regmust != NULL)
-    {
-	int c;
-
-	if (has_mbyte)
-	    c = (*mb_ptr2char)(prog->regmust);
-	else
-	    c = *prog->regmust;
-	s = line + col;
-
-	// This is used very often, esp. for ":global".  Use three versions of
-	// the loop to avoid overhead of conditions.
-	if (!rex.reg_ic && !has_mbyte)
-	    while ((s = vim_strbyte(s, c)) != NULL)
-	    {
-		if (cstrncmp(s, prog->regmust, &prog->regmlen) == 0)
-		    break;		// Found it.
-		++s;
-	    }
-	else if (!rex.reg_ic || (!enc_utf8 && mb_char2len(c) > 1))
-	    while ((s = vim_strchr(s, c)) != NULL)
-	    {
-		if (cstrncmp(s, prog->regmust, &prog->regmlen) == 0)
-		    break;		// Found it.
-		MB_PTR_ADV(s);
-	    }
-	else
-	    while ((s = cstrchr(s, c)) != NULL)
-	    {
-		if (cstrncmp(s, prog->regmust, &prog->regmlen) == 0)
-		    break;		// Found it.
-		MB_PTR_ADV(s);
-	    }
-	if (s == NULL)		// Not present.
-	    goto theend;
-    }
+    // If there is a "must appear" string, look for it.  Doesn't handle
+    // combining chars well.
+    if (prog->regmust != NULL && !rex.reg_icombine
+		       && !cstrmust(line + col, prog->regmust, &prog->regmlen))
+	goto theend;
 
     rex.line = line;
     rex.lnum = 0;
@@ -501,6 +501,292 @@ nfa_get_match_text(nfa_state_T *start)
     return ret;
 }
 
+/*
+ * Literal text found in a part of the postfix form, see nfa_get_regmust().
+ * The strings are in allocated memory, NULL when empty.
+ */
+typedef struct
+{
+    int		exact;	    // "must" is all text this part matches
+    char_u	*prefix;    // text every match of this part starts with
+    char_u	*suffix;    // text every match of this part ends with
+    char_u	*must;	    // longest text every match of this part contains
+} nfa_lit_T;
+
+static char_u nfa_lit_empty[] = "";
+
+    static void
+nfa_lit_clear(nfa_lit_T *lit)
+{
+    VIM_CLEAR(lit->prefix);
+    VIM_CLEAR(lit->suffix);
+    VIM_CLEAR(lit->must);
+    lit->exact = FALSE;
+}
+
+/*
+ * Return the text every match of "lit" starts with ("end" FALSE) or ends with
+ * ("end" TRUE).
+ */
+    static char_u *
+nfa_lit_end(nfa_lit_T *lit, int end)
+{
+    char_u *p = lit->exact ? lit->must : end ? lit->suffix : lit->prefix;
+
+    return p == NULL ? nfa_lit_empty : p;
+}
+
+/*
+ * Return the concatenation of "s1" and "s2" in allocated memory, NULL when
+ * both are empty.
+ */
+    static char_u *
+nfa_lit_concat(char_u *s1, char_u *s2)
+{
+    if (*s1 == NUL && *s2 == NUL)
+	return NULL;
+    return concat_str(s1, s2);
+}
+
+/*
+ * Set "lit1" to the literal text of "lit1" followed by "lit2".  Clears
+ * "lit2".
+ */
+    static void
+nfa_lit_append(nfa_lit_T *lit1, nfa_lit_T *lit2)
+{
+    nfa_lit_T	res;
+    char_u	*mid;
+
+    res.exact = lit1->exact && lit2->exact;
+    res.prefix = NULL;
+    res.suffix = NULL;
+    if (res.exact)
+	res.must = nfa_lit_concat(lit1->must == NULL ? nfa_lit_empty
+								 : lit1->must,
+			   lit2->must == NULL ? nfa_lit_empty : lit2->must);
+    else
+    {
+	if (lit1->exact)
+	    res.prefix = nfa_lit_concat(nfa_lit_end(lit1, FALSE),
+						     nfa_lit_end(lit2, FALSE));
+	else if (lit1->prefix != NULL)
+	    res.prefix = vim_strsave(lit1->prefix);
+	if (lit2->exact)
+	    res.suffix = nfa_lit_concat(nfa_lit_end(lit1, TRUE),
+						      nfa_lit_end(lit2, TRUE));
+	else if (lit2->suffix != NULL)
+	    res.suffix = vim_strsave(lit2->suffix);
+
+	// The longest of: text contained in either part, the text where they
+	// join, the prefix and the suffix.
+	mid = nfa_lit_concat(nfa_lit_end(lit1, TRUE), nfa_lit_end(lit2, FALSE));
+	res.must = mid;
+	if (lit1->must != NULL && !lit1->exact && (res.must == NULL
+				  || STRLEN(lit1->must) > STRLEN(res.must)))
+	    res.must = lit1->must;
+	if (lit2->must != NULL && !lit2->exact && (res.must == NULL
+				 || STRLEN(lit2->must) >= STRLEN(res.must)))
+	    res.must = lit2->must;
+	if (res.prefix != NULL && (res.must == NULL
+				|| STRLEN(res.prefix) > STRLEN(res.must)))
+	    res.must = res.prefix;
+	if (res.suffix != NULL && (res.must == NULL
+				|| STRLEN(res.suffix) > STRLEN(res.must)))
+	    res.must = res.suffix;
+	if (res.must != NULL)
+	    res.must = vim_strsave(res.must);
+	vim_free(mid);
+    }
+
+    nfa_lit_clear(lit1);
+    nfa_lit_clear(lit2);
+    *lit1 = res;
+}
+
+/*
+ * Remove "n" items from the stack "stack", "*spp" points to after the top.
+ * Returns FAIL when there are not enough items.
+ */
+    static int
+nfa_lit_pop(nfa_lit_T *stack, nfa_lit_T **spp, int n)
+{
+    if (*spp - stack < n)
+	return FAIL;
+    while (--n >= 0)
+	nfa_lit_clear(--*spp);
+    return OK;
+}
+
+/*
+ * Find the longest literal text that every match of the postfix form
+ * "postfix" to "end" contains.  Parts that are not plain text, such as
+ * alternatives, repetitions and character classes, end the text.
+ * Return the text in allocated memory or NULL when there is none or when
+ * the pattern may match a line break.
+ */
+    static char_u *
+nfa_get_regmust(int *postfix, int *end)
+{
+    nfa_lit_T	*stack;
+    nfa_lit_T	*sp;
+    int		*p;
+    char_u	buf[MB_MAXBYTES + 1];
+    char_u	*ret = NULL;
+
+    stack = ALLOC_CLEAR_MULT(nfa_lit_T, end - postfix + 1);
+    if (stack == NULL)
+	return NULL;
+    sp = stack;
+
+    for (p = postfix; p < end; ++p)
+    {
+	switch (*p)
+	{
+	    case NFA_NEWL:
+		// The text may continue in the next line.
+		goto theend;
+
+	    case NFA_CONCAT:
+		if (sp - stack < 2)
+		    goto theend;
+		nfa_lit_append(sp - 2, sp - 1);
+		--sp;
+		break;
+
+	    case NFA_MOPEN:
+	    case NFA_MOPEN1:
+	    case NFA_MOPEN2:
+	    case NFA_MOPEN3:
+	    case NFA_MOPEN4:
+	    case NFA_MOPEN5:
+	    case NFA_MOPEN6:
+	    case NFA_MOPEN7:
+	    case NFA_MOPEN8:
+	    case NFA_MOPEN9:
+#ifdef FEAT_SYN_HL
+	    case NFA_ZOPEN:
+	    case NFA_ZOPEN1:
+	    case NFA_ZOPEN2:
+	    case NFA_ZOPEN3:
+	    case NFA_ZOPEN4:
+	    case NFA_ZOPEN5:
+	    case NFA_ZOPEN6:
+	    case NFA_ZOPEN7:
+	    case NFA_ZOPEN8:
+	    case NFA_ZOPEN9:
+#endif
+	    case NFA_NOPEN:
+		// A group matches the same text as what is inside.  An empty
+		// stack is used for an empty pattern, like in post2nfa().
+		if (sp == stack)
+		    (sp++)->exact = TRUE;
+		break;
+
+	    // all kinds of zero-width matches
+	    case NFA_EMPTY:
+	    case NFA_BOL:
+	    case NFA_EOL:
+	    case NFA_BOF:
+	    case NFA_EOF:
+	    case NFA_BOW:
+	    case NFA_EOW:
+	    case NFA_ZSTART:
+	    case NFA_ZEND:
+	    case NFA_CURSOR:
+	    case NFA_VISUAL:
+		(sp++)->exact = TRUE;
+		break;
+
+	    case NFA_LNUM:
+	    case NFA_LNUM_GT:
+	    case NFA_LNUM_LT:
+	    case NFA_VCOL:
+	    case NFA_VCOL_GT:
+	    case NFA_VCOL_LT:
+	    case NFA_COL:
+	    case NFA_COL_GT:
+	    case NFA_COL_LT:
+	    case NFA_MARK:
+	    case NFA_MARK_GT:
+	    case NFA_MARK_LT:
+		++p;  // skip lnum, col or mark name
+		(sp++)->exact = TRUE;
+		break;
+
+	    // Operators with one or two operands that do not match plain
+	    // text.
+	    case NFA_OR:
+	    case NFA_RANGE:
+		if (nfa_lit_pop(stack, &sp, 2) == FAIL)
+		    goto theend;
+		++sp;
+		break;
+
+	    case NFA_PREV_ATOM_JUST_BEFORE:
+	    case NFA_PREV_ATOM_JUST_BEFORE_NEG:
+		++p;  // skip the count
+		// FALLTHROUGH
+	    case NFA_STAR:
+	    case NFA_STAR_NONGREEDY:
+	    case NFA_QUEST:
+	    case NFA_QUEST_NONGREEDY:
+	    case NFA_END_COLL:
+	    case NFA_END_NEG_COLL:
+	    case NFA_PREV_ATOM_NO_WIDTH:
+	    case NFA_PREV_ATOM_NO_WIDTH_NEG:
+	    case NFA_PREV_ATOM_LIKE_PATTERN:
+		if (nfa_lit_pop(stack, &sp, 1) == FAIL)
+		    goto theend;
+		++sp;
+		break;
+
+	    case NFA_COMPOSING:
+		if (sp > stack)
+		    nfa_lit_clear(sp - 1);
+		else
+		    ++sp;
+		break;
+
+	    case NFA_OPT_CHARS:
+		if (nfa_lit_pop(stack, &sp, *++p) == FAIL)
+		    goto theend;
+		++sp;
+		break;
+
+	    default:
+		// Any other operand: a character or something that is not
+		// plain text.
+		if (*p > 0)
+		{
+		    if (has_mbyte)
+			buf[(*mb_char2bytes)(*p, buf)] = NUL;
+		    else
+		    {
+			buf[0] = *p;
+			buf[1] = NUL;
+		    }
+		    sp->must = vim_strsave(buf);
+		    sp->exact = TRUE;
+		}
+		++sp;
+		break;
+	}
+    }
+
+    if (sp - stack == 1 && stack[0].must != NULL)
+    {
+	ret = stack[0].must;
+	stack[0].must = NULL;
+    }
+
+theend:
+    while (sp > stack)
+	nfa_lit_clear(--sp);
+    vim_free(stack);
+    return ret;
+}
+
 /*
  * Allocate more space for post_start.  Called when
  * running above the estimated number of states.
@@ -7104,6 +7390,624 @@ nfa_regtry(
     return 1 + rex.lnum;
 }
 
+/*
+ * State of the DFA built from the NFA, see nfa_dfa_may_match().
+ * Represents a set of NFA states that are active at a position in the text.
+ */
+typedef struct nfa_dstate nfa_dstate_T;
+struct nfa_dstate
+{
+    nfa_dstate_T	*next[256];	// next state for a character below 256,
+					// NULL when not computed yet
+    int			nids;		// number of NFA states in the set
+    char		match;		// a match ends at this position
+    char		eolmatch;	// a match ends at end of the line,
+					// MAYBE when not computed yet
+    char_u		key[1];		// NFA state numbers, used as key in the
+					// hashtable, actually longer
+};
+
+/*
+ * DFA built lazily from the NFA, to quickly find out whether a line can
+ * contain a match at all.  Stored with the program, the states are kept
+ * between calls.
+ */
+struct nfa_dfa_S
+{
+    int			unusable;	// pattern uses an unsupported item
+    int			reg_ic;		// rex.reg_ic used for the states
+    buf_T		*reg_buf;	// rex.reg_buf used for the states
+    int			uses_buf;	// pattern uses "\k" or "\K"
+    int			chartab_tick;	// value of chartab_tick for the states
+    int			flush;		// clear the states before next use
+    int			flush_count;	// number of times states were cleared
+    long		mem;		// memory used by the states
+    hashtab_T		ht;		// all states, key is the "key" member
+    nfa_dstate_T	*first[2];	// state at the start column, index 1
+					// when at the start of the line
+    int			*mark;		// per NFA state: "gen" when visited
+    int			gen;
+    nfa_state_T		**stack;	// NFA states to visit
+    int			*ids;		// NFA state numbers of a set
+    char_u		*key;		// key for a set of NFA states
+};
+
+#define HIKEY2DS(p)  ((nfa_dstate_T *)((p) - offsetof(nfa_dstate_T, key)))
+#define HI2DS(hi)    HIKEY2DS((hi)->hi_key)
+
+// Number of times a program is executed before the DFA is used, avoids the
+// overhead for a pattern that is only used once.
+#define NFA_DFA_MIN_EXEC 4
+
+// Number of bytes in the key for one NFA state.
+#define NFA_DFA_KEYLEN 3
+
+/*
+ * Free all states of "dfa".
+ */
+    static void
+nfa_dfa_clear(nfa_dfa_T *dfa)
+{
+    hashitem_T	*hi;
+    long	todo = (long)dfa->ht.ht_used;
+
+    for (hi = dfa->ht.ht_array; todo > 0; ++hi)
+	if (!HASHITEM_EMPTY(hi))
+	{
+	    --todo;
+	    vim_free(HI2DS(hi));
+	}
+    hash_clear(&dfa->ht);
+    hash_init(&dfa->ht);
+    dfa->first[0] = NULL;
+    dfa->first[1] = NULL;
+    dfa->mem = 0;
+}
+
+    static void
+nfa_dfa_free(nfa_dfa_T *dfa)
+{
+    if (dfa == NULL)
+	return;
+    nfa_dfa_clear(dfa);
+    vim_free(dfa->mark);
+    vim_free(dfa->stack);
+    vim_free(dfa->ids);
+    vim_free(dfa->key);
+    vim_free(dfa);
+}
+
+/*
+ * Allocate the DFA for "prog".  Returns NULL when out of memory.
+ */
+    static nfa_dfa_T *
+nfa_dfa_alloc(nfa_regprog_T *prog)
+{
+    nfa_dfa_T	*dfa;
+    int		i;
+
+    dfa = ALLOC_CLEAR_ONE(nfa_dfa_T);
+    if (dfa == NULL)
+	return NULL;
+    hash_init(&dfa->ht);
+    dfa->mark = ALLOC_CLEAR_MULT(int, prog->nstate);
+    // Every state is visited once and adds at most two states.
+    dfa->stack = ALLOC_MULT(nfa_state_T *, prog->nstate * 2 + 1);
+    dfa->ids = ALLOC_MULT(int, prog->nstate);
+    dfa->key = alloc(prog->nstate * NFA_DFA_KEYLEN + 1);
+    if (dfa->mark == NULL || dfa->stack == NULL || dfa->ids == NULL
+							  || dfa->key == NULL)
+    {
+	nfa_dfa_free(dfa);
+	return NULL;
+    }
+    dfa->reg_ic = rex.reg_ic;
+    dfa->reg_buf = rex.reg_buf;
+    dfa->chartab_tick = chartab_tick;
+    for (i = 0; i < prog->nstate; ++i)
+	if (prog->state[i].c == NFA_KWORD || prog->state[i].c == NFA_SKWORD)
+	    dfa->uses_buf = TRUE;
+    // The key uses three bytes for a state number.
+    if (prog->nstate >= 255 * 255 * 255)
+	dfa->unusable = TRUE;
+    return dfa;
+}
+
+/*
+ * Add the NFA states that can be reached from "state" without consuming a
+ * character to "dfa->ids".  "*count" is the number of states in it.
+ * States that consume a character, NFA_MATCH and NFA_EOL when not at the end
+ * of the line are added.  Other zero-width items, such as "\<" and "\zs", are
+ * passed over as if they always match.  A look-around is skipped.
+ * Since "dfa->mark" is used, states are only added once per "dfa->gen".
+ * Returns FAIL when finding an item that the DFA does not support.
+ */
+    static int
+nfa_dfa_closure(
+    nfa_regprog_T   *prog,
+    nfa_dfa_T	    *dfa,
+    nfa_state_T	    *state,
+    int		    bol,	// at the start of the line
+    int		    eol,	// at the end of the line
+    int		    *count)
+{
+    nfa_state_T	**sp = dfa->stack;
+    int		idx;
+
+    *sp++ = state;
+    while (sp > dfa->stack)
+    {
+	state = *--sp;
+	idx = (int)(state - prog->state);
+	if (dfa->mark[idx] == dfa->gen)
+	    continue;
+	dfa->mark[idx] = dfa->gen;
+
+	switch (state->c)
+	{
+	    case NFA_SPLIT:
+		*sp++ = state->out1;
+		*sp++ = state->out;
+		break;
+
+	    case NFA_BOL:
+		if (bol)
+		    *sp++ = state->out;
+		break;
+
+	    case NFA_EOL:
+		if (eol)
+		    *sp++ = state->out;
+		else
+		    dfa->ids[(*count)++] = idx;
+		break;
+
+	    case NFA_EMPTY:
+	    case NFA_BOW:
+	    case NFA_EOW:
+	    case NFA_BOF:
+	    case NFA_EOF:
+	    case NFA_ZSTART:
+	    case NFA_ZEND:
+	    case NFA_CURSOR:
+	    case NFA_VISUAL:
+	    case NFA_LNUM:
+	    case NFA_LNUM_GT:
+	    case NFA_LNUM_LT:
+	    case NFA_COL:
+	    case NFA_COL_GT:
+	    case NFA_COL_LT:
+	    case NFA_VCOL:
+	    case NFA_VCOL_GT:
+	    case NFA_VCOL_LT:
+	    case NFA_MARK:
+	    case NFA_MARK_GT:
+	    case NFA_MARK_LT:
+	    case NFA_MOPEN:
+	    case NFA_MOPEN1:
+	    case NFA_MOPEN2:
+	    case NFA_MOPEN3:
+	    case NFA_MOPEN4:
+	    case NFA_MOPEN5:
+	    case NFA_MOPEN6:
+	    case NFA_MOPEN7:
+	    case NFA_MOPEN8:
+	    case NFA_MOPEN9:
+	    case NFA_MCLOSE:
+	    case NFA_MCLOSE1:
+	    case NFA_MCLOSE2:
+	    case NFA_MCLOSE3:
+	    case NFA_MCLOSE4:
+	    case NFA_MCLOSE5:
+	    case NFA_MCLOSE6:
+	    case NFA_MCLOSE7:
+	    case NFA_MCLOSE8:
+	    case NFA_MCLOSE9:
+#ifdef FEAT_SYN_HL
+	    case NFA_ZOPEN:
+	    case NFA_ZOPEN1:
+	    case NFA_ZOPEN2:
+	    case NFA_ZOPEN3:
+	    case NFA_ZOPEN4:
+	    case NFA_ZOPEN5:
+	    case NFA_ZOPEN6:
+	    case NFA_ZOPEN7:
+	    case NFA_ZOPEN8:
+	    case NFA_ZOPEN9:
+	    case NFA_ZCLOSE:
+	    case NFA_ZCLOSE1:
+	    case NFA_ZCLOSE2:
+	    case NFA_ZCLOSE3:
+	    case NFA_ZCLOSE4:
+	    case NFA_ZCLOSE5:
+	    case NFA_ZCLOSE6:
+	    case NFA_ZCLOSE7:
+	    case NFA_ZCLOSE8:
+	    case NFA_ZCLOSE9:
+#endif
+	    case NFA_NOPEN:
+	    case NFA_NCLOSE:
+		*sp++ = state->out;
+		break;
+
+	    case NFA_START_INVISIBLE:
+	    case NFA_START_INVISIBLE_FIRST:
+	    case NFA_START_INVISIBLE_NEG:
+	    case NFA_START_INVISIBLE_NEG_FIRST:
+	    case NFA_START_INVISIBLE_BEFORE:
+	    case NFA_START_INVISIBLE_BEFORE_FIRST:
+	    case NFA_START_INVISIBLE_BEFORE_NEG:
+	    case NFA_START_INVISIBLE_BEFORE_NEG_FIRST:
+		// continue with what follows NFA_END_INVISIBLE
+		*sp++ = state->out1->out;
+		break;
+
+	    case NFA_MATCH:
+	    case NFA_ANY:
+	    case NFA_START_COLL:
+	    case NFA_START_NEG_COLL:
+		dfa->ids[(*count)++] = idx;
+		break;
+
+	    default:
+		if (state->c > 0
+			|| (state->c >= NFA_IDENT && state->c <= NFA_NUPPER_IC))
+		    dfa->ids[(*count)++] = idx;
+		else
+		    // back references, line breaks, "\@>", composing
+		    // characters, etc.
+		    return FAIL;
+		break;
+	}
+    }
+    return OK;
+}
+
+/*
+ * Return TRUE if NFA state "state", which consumes a character, matches
+ * character "c".  Must do the same as nfa_regmatch().
+ */
+    static int
+nfa_dfa_char_match(nfa_state_T *state, int c)
+{
+    nfa_state_T	*cs;
+    int		c1, c2;
+
+    switch (state->c)
+    {
+	case NFA_ANY:	    return TRUE;
+	case NFA_IDENT:	    return vim_isIDc(c);
+	case NFA_SIDENT:    return !VIM_ISDIGIT(c) && vim_isIDc(c);
+	case NFA_KWORD:	    return vim_iswordc_buf(c, rex.reg_buf);
+	case NFA_SKWORD:    return !VIM_ISDIGIT(c)
+					       && vim_iswordc_buf(c, rex.reg_buf);
+	case NFA_FNAME:	    return vim_isfilec(c);
+	case NFA_SFNAME:    return !VIM_ISDIGIT(c) && vim_isfilec(c);
+	case NFA_PRINT:	    return vim_isprintc(c);
+	case NFA_SPRINT:    return !VIM_ISDIGIT(c) && vim_isprintc(c);
+	case NFA_WHITE:	    return VIM_ISWHITE(c);
+	case NFA_NWHITE:    return !VIM_ISWHITE(c);
+	case NFA_DIGIT:	    return ri_digit(c);
+	case NFA_NDIGIT:    return !ri_digit(c);
+	case NFA_HEX:	    return ri_hex(c);
+	case NFA_NHEX:	    return !ri_hex(c);
+	case NFA_OCTAL:	    return ri_octal(c);
+	case NFA_NOCTAL:    return !ri_octal(c);
+	case NFA_WORD:	    return ri_word(c);
+	case NFA_NWORD:	    return !ri_word(c);
+	case NFA_HEAD:	    return ri_head(c);
+	case NFA_NHEAD:	    return !ri_head(c);
+	case NFA_ALPHA:	    return ri_alpha(c);
+	case NFA_NALPHA:    return !ri_alpha(c);
+	case NFA_LOWER:	    return ri_lower(c);
+	case NFA_NLOWER:    return !ri_lower(c);
+	case NFA_UPPER:	    return ri_upper(c);
+	case NFA_NUPPER:    return !ri_upper(c);
+	case NFA_LOWER_IC:  return ri_lower(c) || (rex.reg_ic && ri_upper(c));
+	case NFA_NLOWER_IC: return !(ri_lower(c)
+					       || (rex.reg_ic && ri_upper(c)));
+	case NFA_UPPER_IC:  return ri_upper(c) || (rex.reg_ic && ri_lower(c));
+	case NFA_NUPPER_IC: return !(ri_upper(c)
+					       || (rex.reg_ic && ri_lower(c)));
+
+	case NFA_START_COLL:
+	case NFA_START_NEG_COLL:
+	    for (cs = state->out; cs->c != NFA_END_COLL; cs = cs->out)
+	    {
+		if (cs->c == NFA_RANGE_MIN)
+		{
+		    c1 = cs->val;
+		    cs = cs->out; // advance to NFA_RANGE_MAX
+		    c2 = cs->val;
+		    if (c >= c1 && c <= c2)
+			break;
+		    if (rex.reg_ic)
+		    {
+			int c_low = MB_TOLOWER(c);
+
+			for ( ; c1 <= c2; ++c1)
+			    if (MB_TOLOWER(c1) == c_low)
+				break;
+			if (c1 <= c2)
+			    break;
+		    }
+		}
+		else if (cs->c < 0 ? check_char_class(cs->c, c)
+			    : (c == cs->c || (rex.reg_ic
+					     && MB_TOLOWER(c) == MB_TOLOWER(cs->c))))
+		    break;
+	    }
+	    return (cs->c != NFA_END_COLL) == (state->c == NFA_START_COLL);
+
+	default:
+	    // regular character
+	    return c == state->c
+		       || (rex.reg_ic && MB_TOLOWER(c) == MB_TOLOWER(state->c));
+    }
+}
+
+    static int
+nfa_dfa_idcmp(const void *a, const void *b)
+{
+    return *(int *)a - *(int *)b;
+}
+
+/*
+ * Find or add the DFA state for the "count" NFA states in "dfa->ids".
+ * Returns NULL when out of memory or above the memory limit.
+ */
+    static nfa_dstate_T *
+nfa_dfa_state(nfa_regprog_T *prog, nfa_dfa_T *dfa, int count)
+{
+    nfa_dstate_T    *ds;
+    hashitem_T	    *hi;
+    hash_T	    hash;
+    char_u	    *p = dfa->key;
+    int		    i;
+    int		    id;
+
+    qsort(dfa->ids, (size_t)count, sizeof(int), nfa_dfa_idcmp);
+    for (i = 0; i < count; ++i)
+    {
+	// Avoid NUL bytes, the hashtable uses a string key.
+	id = dfa->ids[i];
+	*p++ = id % 255 + 1;
+	*p++ = (id / 255) % 255 + 1;
+	*p++ = id / (255 * 255) + 1;
+    }
+    *p = NUL;
+
+    hash = hash_hash(dfa->key);
+    hi = hash_lookup(&dfa->ht, dfa->key, hash);
+    if (!HASHITEM_EMPTY(hi))
+	return HI2DS(hi);
+
+    // Clear all states before the next use when using too much memory.
+    if ((dfa->mem >> 10) >= p_mmp)
+    {
+	dfa->flush = TRUE;
+	return NULL;
+    }
+
+    ds = alloc_clear(sizeof(nfa_dstate_T) + count * NFA_DFA_KEYLEN);
+    if (ds == NULL)
+	return NULL;
+    STRCPY(ds->key, dfa->key);
+    ds->nids = count;
+    ds->eolmatch = MAYBE;
+    for (i = 0; i < count; ++i)
+	if (prog->state[dfa->ids[i]].c == NFA_MATCH)
+	    ds->match = TRUE;
+    if (hash_add_item(&dfa->ht, hi, ds->key, hash) == FAIL)
+    {
+	vim_free(ds);
+	return NULL;
+    }
+    dfa->mem += sizeof(nfa_dstate_T) + count * NFA_DFA_KEYLEN;
+    return ds;
+}
+
+/*
+ * Get the NFA state for entry "i" in the key of "ds".
+ */
+    static nfa_state_T *
+nfa_dfa_key_state(nfa_regprog_T *prog, nfa_dstate_T *ds, int i)
+{
+    char_u *p = ds->key + i * NFA_DFA_KEYLEN;
+
+    return &prog->state[(p[0] - 1) + (p[1] - 1) * 255
+							+ (p[2] - 1) * 255 * 255];
+}
+
+/*
+ * Compute the DFA state that follows "ds" after character "c".  When "ds"
+ * is NULL compute the state at the start column.
+ * Returns NULL when that fails, the DFA can't be used then.
+ */
+    static nfa_dstate_T *
+nfa_dfa_next(
+    nfa_regprog_T   *prog,
+    nfa_dfa_T	    *dfa,
+    nfa_dstate_T    *ds,
+    int		    c,
+    int		    bol)
+{
+    nfa_state_T	*state;
+    int		count = 0;
+    int		i;
+
+    if (++dfa->gen <= 0)
+    {
+	vim_memset(dfa->mark, 0, prog->nstate * sizeof(int));
+	dfa->gen = 1;
+    }
+    if (ds != NULL)
+	for (i = 0; i < ds->nids; ++i)
+	{
+	    state = nfa_dfa_key_state(prog, ds, i);
+	    if (state->c == NFA_MATCH || state->c == NFA_EOL
+					       || !nfa_dfa_char_match(state, c))
+		continue;
+	    // What follows a collection is after NFA_END_COLL.
+	    if (state->c == NFA_START_COLL || state->c == NFA_START_NEG_COLL)
+		state = state->out1->out;
+	    else
+		state = state->out;
+	    if (nfa_dfa_closure(prog, dfa, state, FALSE, FALSE, &count)
+									== FAIL)
+	    {
+		dfa->unusable = TRUE;
+		return NULL;
+	    }
+	}
+
+    // A match may start at every position, unless it is anchored.
+    if ((ds == NULL || !prog->reganch)
+	    && nfa_dfa_closure(prog, dfa, prog->start, bol, FALSE, &count)
+									== FAIL)
+    {
+	dfa->unusable = TRUE;
+	return NULL;
+    }
+    return nfa_dfa_state(prog, dfa, count);
+}
+
+/*
+ * Return TRUE if a match ends at the end of the line for DFA state "ds".
+ */
+    static int
+nfa_dfa_eolmatch(nfa_regprog_T *prog, nfa_dfa_T *dfa, nfa_dstate_T *ds)
+{
+    nfa_state_T	*state;
+    int		count = 0;
+    int		i;
+
+    if (ds->eolmatch != MAYBE)
+	return ds->eolmatch;
+    if (++dfa->gen <= 0)
+    {
+	vim_memset(dfa->mark, 0, prog->nstate * sizeof(int));
+	dfa->gen = 1;
+    }
+    ds->eolmatch = ds->match;
+    for (i = 0; i < ds->nids && !ds->eolmatch; ++i)
+    {
+	state = nfa_dfa_key_state(prog, ds, i);
+	if (state->c != NFA_EOL)
+	    continue;
+	// Also pass "^" after "$", it only matters for an empty line.
+	if (nfa_dfa_closure(prog, dfa, state->out, TRUE, TRUE, &count) == FAIL)
+	    ds->eolmatch = TRUE;
+    }
+    for (i = 0; i < count && !ds->eolmatch; ++i)
+	if (prog->state[dfa->ids[i]].c == NFA_MATCH)
+	    ds->eolmatch = TRUE;
+    return ds->eolmatch;
+}
+
+/*
+ * Check with the DFA if "line" may contain a match that starts at or after
+ * column "col".  The DFA is built while going over the text and kept for the
+ * next call.  Its states are sets of NFA states, stepping to the next
+ * character does not have to go over those states again.  Items that depend
+ * on more than the current character, such as "\<" and look-behind, are
+ * assumed to match, thus when the DFA finds a match the NFA still needs to
+ * check it.  Patterns with back references, line breaks and other items
+ * that the DFA cannot handle don't use it.
+ * Returns FALSE when there is no match, TRUE when there may be a match.
+ */
+    static int
+nfa_dfa_may_match(nfa_regprog_T *prog, char_u *line, colnr_T col)
+{
+    nfa_dfa_T	    *dfa = prog->dfa;
+    nfa_dstate_T    *ds;
+    nfa_dstate_T    *next;
+    char_u	    *p = line + col;
+    int		    c;
+    int		    len;
+
+    // Not worth it for a pattern that is used only a few times.
+    if (prog->nexec < NFA_DFA_MIN_EXEC)
+    {
+	++prog->nexec;
+	return TRUE;
+    }
+    if (rex.reg_icombine || rex.reg_line_lbr)
+	return TRUE;
+    if (dfa == NULL)
+    {
+	dfa = nfa_dfa_alloc(prog);
+	if (dfa == NULL)
+	    return TRUE;
+	prog->dfa = dfa;
+    }
+    if (dfa->unusable)
+	return TRUE;
+
+    // The states depend on 'ignorecase' and the character classes.
+    if (dfa->flush || dfa->reg_ic != rex.reg_ic
+	    || dfa->chartab_tick != chartab_tick
+	    || (dfa->uses_buf && dfa->reg_buf != rex.reg_buf))
+    {
+	nfa_dfa_clear(dfa);
+	// When states keep on being cleared give up.
+	if (dfa->flush && ++dfa->flush_count > 10)
+	{
+	    dfa->unusable = TRUE;
+	    return TRUE;
+	}
+	dfa->flush = FALSE;
+	dfa->reg_ic = rex.reg_ic;
+	dfa->reg_buf = rex.reg_buf;
+	dfa->chartab_tick = chartab_tick;
+    }
+
+    ds = dfa->first[col == 0];
+    if (ds == NULL)
+    {
+	ds = nfa_dfa_next(prog, dfa, NULL, NUL, col == 0);
+	if (ds == NULL)
+	    return TRUE;
+	dfa->first[col == 0] = ds;
+    }
+
+    for (;;)
+    {
+	if (ds->match)
+	    return TRUE;
+	if (ds->nids == 0)
+	    return FALSE;
+
+	if (has_mbyte)
+	{
+	    c = (*mb_ptr2char)(p);
+	    len = (*mb_ptr2len)(p);
+	    // Composing characters are not handled.
+	    if (enc_utf8 && len > 1 && len != utf_ptr2len(p))
+		return TRUE;
+	}
+	else
+	{
+	    c = *p;
+	    len = 1;
+	}
+	if (c == NUL)
+	    return nfa_dfa_eolmatch(prog, dfa, ds);
+
+	next = c < 256 ? ds->next[c] : NULL;
+	if (next == NULL)
+	{
+	    next = nfa_dfa_next(prog, dfa, ds, c, FALSE);
+	    if (next == NULL)
+		return TRUE;
+	    if (c < 256)
+		ds->next[c] = next;
+	}
+	ds = next;
+	p += len;
+    }
+}
+
 /*
  * Match a regexp against a string ("line" points to the string) or multiple
  * lines ("line" is NULL, use reg_getline()).
@@ -7168,6 +8072,14 @@ nfa_regexec_both(
     if (prog->reganch && col > 0)
 	return 0L;
 
+    // If there is a "must appear" string, look for it.  Lines without it
+    // cannot match.
+    // Doesn't handle combining chars well.
+    if (prog->regmust != NULL && prog->match_text == NULL
+	    && !rex.reg_icombine
+	    && !cstrmust(line + col, prog->regmust, &prog->regmlen))
+	return 0L;
+
     rex.need_clear_subexpr = TRUE;
 #ifdef FEAT_SYN_HL
     // Clear the external match subpointers if necessary.
@@ -7200,6 +8112,10 @@ nfa_regexec_both(
     if (rex.reg_maxcol > 0 && col >= rex.reg_maxcol)
 	goto theend;
 
+    // Quickly check if the line can contain a match at all.
+    if (!nfa_dfa_may_match(prog, line, col))
+	goto theend;
+
     // Set the "nstate" used by nfa_regcomp() to zero to trigger an error when
     // it's accidentally used during execution.
     nstate = 0;
@@ -7301,6 +8217,10 @@ nfa_regcomp(char_u *expr, int re_flags)
     prog->reganch = nfa_get_reganch(prog->start, 0);
     prog->regstart = nfa_get_regstart(prog->start, 0);
     prog->match_text = nfa_get_match_text(prog->start);
+    prog->regmust = nfa_get_regmust(postfix, post_ptr);
+    prog->regmlen = prog->regmust == NULL ? 0 : (int)STRLEN(prog->regmust);
+    prog->dfa = NULL;
+    prog->nexec = 0;
 
 #ifdef ENABLE_LOG
     nfa_postfix_dump(expr, OK);
@@ -7341,6 +8261,8 @@ nfa_regfree(regprog_T *prog)
     if (prog != NULL)
     {
 	vim_free(((nfa_regprog_T *)prog)->match_text);
+	vim_free(((nfa_regprog_T *)prog)->regmust);
+	nfa_dfa_free(((nfa_regprog_T *)prog)->dfa);
 	vim_free(((nfa_regprog_T *)prog)->pattern);
 	vim_free(prog);
     }
@@ -56,6 +56,34 @@ static void recording_mode(int attr);
 // Ugly global: overrule attribute used by screen_char()
 static int screen_char_attr = 0;
 
+/*
+ * Clearing to the end of a screen line is postponed when possible.  Quite
+ * often the same text is drawn again right away, e.g. the ruler or the mode
+ * message after msg_clr_eos().  Instead of sending T_CE and then the same
+ * characters, the text that is still in the terminal is remembered in
+ * clr_lines[], clr_attrs[] and clr_uc[], and screen_char() skips writing a
+ * character that is already there.  screen_flush_clear() sends what is still
+ * needed, at the latest before waiting for the user to type a character.
+ * Only one screen row can be pending, it is "clr_row", -1 when there is none.
+ */
+static int	clr_row = -1;
+static int	clr_col;	    // first column that may be pending
+static int	clr_len = 0;	    // allocated size of the clr_ arrays
+static schar_T	*clr_lines = NULL;
+static sattr_T	*clr_attrs = NULL;
+static u8char_T	*clr_uc = NULL;
+static char_u	*clr_state = NULL;
+
+#define CLR_DONE    0	// terminal shows what is in ScreenLines[]
+#define CLR_OLD	    1	// terminal shows what is in clr_lines[]
+
+// ScreenLines["off"] is a space without attributes
+#define CLR_BLANK(off) (ScreenLines[off] == ' ' && ScreenAttrs[off] == 0 \
+				    && (!enc_utf8 || ScreenLinesUC[off] == 0))
+// ScreenLines["off"] is the right half of a double-width character
+#define CLR_RIGHT_HALF(off) (ScreenLines[off] == NUL \
+				    && (!enc_utf8 || ScreenLinesUC[off] == 0))
+
 #if defined(FEAT_CONCEAL) || defined(PROTO)
 /*
  * Return TRUE if the cursor line in window "wp" may be concealed, according
@@ -2086,6 +2114,121 @@ reset_cterm_colors(void)
     }
 }
 
+/*
+ * Return TRUE if the character at ScreenLines["off"] occupies one cell and
+ * can be remembered in the clr_ arrays.
+ */
+    static int
+clr_simple_char(unsigned off)
+{
+    if (ScreenAttrs[off] == (sattr_T)-1)
+	return FALSE;
+    if (enc_utf8 && ScreenLinesUC[off] != 0)
+	return utf_char2cells(ScreenLinesUC[off]) == 1
+		&& !utf_ambiguous_width(ScreenLinesUC[off])
+		&& (Screen_mco == 0 || ScreenLinesC[0][off] == 0);
+    return ScreenLines[off] != NUL;
+}
+
+/*
+ * Return TRUE if the terminal still shows the character at ScreenLines["off"]
+ * in column "col" of the pending row.
+ */
+    static int
+clr_same_char(unsigned off, int col)
+{
+    return clr_lines[col] == ScreenLines[off]
+	    && clr_attrs[col] == ScreenAttrs[off]
+	    && (!enc_utf8 || clr_uc[col] == ScreenLinesUC[off])
+	    && clr_simple_char(off);
+}
+
+/*
+ * Called instead of clearing "row" from column "col" to the end with T_CE.
+ * Remembers what the terminal shows and blanks ScreenLines[] for the cleared
+ * part.  Returns FALSE when the clear can't be postponed, nothing was changed
+ * then.
+ */
+    static int
+clr_postpone(int row, int col)
+{
+    int		c;
+    unsigned	off;
+
+    if (
+#ifdef FEAT_GUI
+	    gui.in_use ||
+#endif
+	    p_wiv || enc_dbcs != 0 || pum_visible()
+	    // the last cell may not be written, it must be cleared
+	    || (*T_XN == NUL && row == screen_Rows - 1))
+    {
+	if (clr_row == row)
+	    screen_flush_clear();
+	return FALSE;
+    }
+
+    if (clr_len != screen_Columns)
+    {
+	vim_free(clr_lines);
+	vim_free(clr_attrs);
+	vim_free(clr_uc);
+	vim_free(clr_state);
+	clr_lines = LALLOC_MULT(schar_T, screen_Columns);
+	clr_attrs = LALLOC_MULT(sattr_T, screen_Columns);
+	clr_uc = LALLOC_MULT(u8char_T, screen_Columns);
+	clr_state = alloc_clear(screen_Columns);
+	if (clr_lines == NULL || clr_attrs == NULL || clr_uc == NULL
+							   || clr_state == NULL)
+	{
+	    VIM_CLEAR(clr_lines);
+	    VIM_CLEAR(clr_attrs);
+	    VIM_CLEAR(clr_uc);
+	    VIM_CLEAR(clr_state);
+	    clr_len = 0;
+	    clr_row = -1;
+	    return FALSE;
+	}
+	clr_len = screen_Columns;
+	clr_row = -1;
+    }
+
+    if (clr_row != row)
+    {
+	screen_flush_clear();
+	vim_memset(clr_state, CLR_DONE, clr_len);
+	clr_col = col;
+    }
+
+    // The characters of which the terminal is not known to show the old
+    // text must all be simple, otherwise clear right away.
+    off = LineOffset[row] + col;
+    for (c = col; c < screen_Columns; ++c, ++off)
+	if (clr_state[c] == CLR_DONE && !clr_simple_char(off))
+	{
+	    if (clr_row == row)
+		screen_flush_clear();
+	    return FALSE;
+	}
+
+    off = LineOffset[row] + col;
+    for (c = col; c < screen_Columns; ++c, ++off)
+    {
+	if (clr_state[c] == CLR_DONE && !CLR_BLANK(off))
+	{
+	    clr_lines[c] = ScreenLines[off];
+	    clr_attrs[c] = ScreenAttrs[off];
+	    clr_uc[c] = enc_utf8 ? ScreenLinesUC[off] : 0;
+	    clr_state[c] = CLR_OLD;
+	}
+	space_to_screenline(off, 0);
+    }
+    clr_row = row;
+    if (col < clr_col)
+	clr_col = col;
+    return TRUE;
+}
+
 /*
  * Put character ScreenLines["off"] on the screen at position "row" and "col",
  * using the attributes from ScreenAttrs["off"].
@@ -2135,6 +2278,21 @@ screen_char(unsigned off, int row, int col)
 	attr = screen_char_attr;
     else
 	attr = ScreenAttrs[off];
+    if (row == clr_row && col >= clr_col)
+    {
+	// Nothing to do when the terminal still shows this character.
+	if (clr_state[col] == CLR_OLD && screen_char_attr == 0
+						    && clr_same_char(off, col))
+	{
+	    clr_state[col] = CLR_DONE;
+	    return;
+	}
+	clr_state[col] = CLR_DONE;
+	if (col + 1 < clr_len && enc_utf8 && ScreenLinesUC[off] != 0
+				     && utf_char2cells(ScreenLinesUC[off]) > 1)
+	    clr_state[col + 1] = CLR_DONE;
+    }
+
     if (screen_attr != attr)
 	screen_stop_highlight();
 
@@ -2192,6 +2350,123 @@ screen_char(unsigned off, int row, int col)
     screen_cur_col++;
 }
 
+/*
+ * Send what is needed for a postponed clear to end of line, so that the
+ * terminal shows what is in ScreenLines[].  Keeps the cursor position.
+ */
+    void
+screen_flush_clear(void)
+{
+    int		row = clr_row;
+    int		col;
+    int		end_col;
+    int		clear_col;	// column to clear from, -1 for none
+    int		first_col = -1;	// first column that needs to be written
+    int		can_ce;
+    int		ce_cost;
+    int		write_cost = 0;
+    int		redraw_cost = 0;
+    int		prev = FALSE;
+    int		save_row = screen_cur_row;
+    int		save_col = screen_cur_col;
+    unsigned	off;
+    unsigned	line_off;
+
+    if (row < 0)
+	return;
+    clr_row = -1;
+    if (ScreenLines == NULL || row >= screen_Rows || clr_len != screen_Columns)
+	return;
+    line_off = LineOffset[row];
+    can_ce = can_clear(T_CE) && !pum_visible();
+
+    // Find where only blanks are left, these can be cleared with T_CE.
+    end_col = screen_Columns;
+    for (off = line_off + end_col - 1; end_col > clr_col; --end_col, --off)
+	if (!CLR_BLANK(off))
+	    break;
+    clear_col = -1;
+    for (col = end_col; col < screen_Columns; ++col)
+	if (clr_state[col] == CLR_OLD)
+	{
+	    clear_col = end_col;
+	    break;
+	}
+    if (clear_col >= 0 && !can_ce)
+    {
+	clear_col = -1;
+	end_col = screen_Columns;
+    }
+
+    // Writing the changed characters may cost more than clearing from the
+    // first changed one and writing what is not blank, guess which is
+    // cheaper.  Moving the cursor counts as a few characters.
+    off = line_off + clr_col;
+    for (col = clr_col; col < end_col; ++col, ++off)
+    {
+	if (clr_state[col] == CLR_OLD && !clr_same_char(off, col)
+						       && !CLR_RIGHT_HALF(off))
+	{
+	    if (first_col < 0)
+		first_col = col;
+	    write_cost += prev ? 1 : 5;
+	    prev = TRUE;
+	}
+	else
+	    prev = FALSE;
+    }
+    if (first_col >= 0 && can_ce)
+    {
+	ce_cost = (int)STRLEN(T_CE) + 5;
+	prev = FALSE;
+	off = line_off + first_col;
+	for (col = first_col; col < end_col; ++col, ++off)
+	{
+	    if (!CLR_BLANK(off))
+	    {
+		redraw_cost += prev ? 1 : 5;
+		prev = TRUE;
+	    }
+	    else
+		prev = FALSE;
+	}
+	if (ce_cost + redraw_cost < write_cost + (clear_col >= 0 ? ce_cost : 0))
+	    clear_col = first_col;
+    }
+
+    if (clear_col >= 0)
+    {
+	screen_stop_highlight();
+	term_windgoto(row, clear_col);
+	out_str(T_CE);
+	screen_start();
+    }
+    if (first_col >= 0)
+    {
+	off = line_off + first_col;
+	for (col = first_col; col < end_col; ++col, ++off)
+	{
+	    if (clear_col >= 0 && col >= clear_col
+			 ? !CLR_BLANK(off) && !CLR_RIGHT_HALF(off)
+			 : clr_state[col] == CLR_OLD && !clr_same_char(off, col)
+						       && !CLR_RIGHT_HALF(off))
+		screen_char(off, row, col);
+	    if (enc_utf8 && ScreenLinesUC[off] != 0
+				       && utf_char2cells(ScreenLinesUC[off]) > 1)
+	    {
+		++col;
+		++off;
+	    }
+	}
+    }
+
+    if (save_row < screen_Rows && save_col < screen_Columns)
+    {
+	screen_stop_highlight();
+	windgoto(save_row, save_col);
+    }
+}
+
 /*
  * Used for enc_dbcs only: Put one double-wide character at ScreenLines["off"]
  * on the screen at position 'row' and 'col'.
@@ -2390,6 +2665,9 @@ screen_fill(
 		while (off < end_off && ScreenLines[off] == ' '
 						     && ScreenAttrs[off] == 0)
 		    ++off;
+	    if (off < end_off && clr_postpone(row,
+						 (int)(off - LineOffset[row])))
+		off = end_off;
 	    if (off < end_off)		// something to be cleared
 	    {
 		col = off - LineOffset[row];
@@ -2907,6 +3185,12 @@ free_screenlines(void)
     VIM_CLEAR(LineOffset);
     VIM_CLEAR(LineWraps);
     VIM_CLEAR(TabPageIdxs);
+    VIM_CLEAR(clr_lines);
+    VIM_CLEAR(clr_attrs);
+    VIM_CLEAR(clr_uc);
+    VIM_CLEAR(clr_state);
+    clr_len = 0;
+    clr_row = -1;
 #ifdef FEAT_PROP_POPUP
     VIM_CLEAR(popup_mask);
     VIM_CLEAR(popup_mask_next);
@@ -2939,6 +3223,7 @@ screenclear2(void)
 #endif
 	screen_attr = -1;	// force setting the Normal colors
     screen_stop_highlight();	// don't want highlighting here
+    clr_row = -1;		// a postponed clear is not needed now
 
 #ifdef FEAT_CLIPBOARD
     // disable selection without redrawing it
@@ -3293,6 +3578,8 @@ windgoto(int row, int col)
 			    if (enc_dbcs == DBCS_JPNU
 						  && ScreenLines[off] == 0x8e)
 				out_char(ScreenLines2[off]);
+			    if (row == clr_row)
+				clr_state[off - LineOffset[row]] = CLR_DONE;
 			    ++off;
 			}
 		    }
@@ -3699,6 +3986,11 @@ screen_ins_lines(
     else
 	return FAIL;
 
+    // Lines in the region will move, the terminal must show what is in
+    // ScreenLines[] for them.
+    if (clr_row >= off + row && clr_row < off + end)
+	screen_flush_clear();
+
     /*
      * For clearing the lines screen_del_lines() is used. This will also take
      * care of t_db if necessary.
@@ -3943,6 +4235,11 @@ screen_del_lines(
     else
 	return FAIL;
 
+    // Lines in the region will move, the terminal must show what is in
+    // ScreenLines[] for them.  T_CD also clears below the region.
+    if (clr_row >= off + row && (clr_row < off + end || type == USE_T_CD))
+	screen_flush_clear();
+
 #ifdef FEAT_CLIPBOARD
     // Remove a modeless selection when deleting lines halfway the screen or
     // not the full width of the screen.
@@ -204,6 +204,233 @@ source_callback(char_u *fname, void *cookie)
     (void)do_source(fname, FALSE, DOSO_NONE, cookie);
 }
 
+#if defined(TEMPDIRNAMES) || defined(FEAT_EVAL) || defined(PROTO)
+/*
+ * Index of the names in the directories of 'runtimepath' and 'packpath'.
+ * Most patterns that do_in_path() looks for, e.g. "ftplugin/vim.vim" or
+ * "autoload/foo.vim", start with a name that does not exist in most of the
+ * directories.  Looking up that name in the index avoids expanding the
+ * pattern.  An entry is re-read when the modification time of the
+ * directory changed.
+ */
+typedef struct {
+    int		rd_state;	// RD_ values
+    time_t	rd_mtime;	// mtime of the directory when it was read
+    hashtab_T	rd_names;	// names in the directory
+    char_u	rd_dir[1];	// directory name, actually longer
+} rtpdir_T;
+
+# define RD_MISSING	0	// directory does not exist
+# define RD_INDEXED	1	// names are in rd_names
+# define RD_UNKNOWN	2	// recently changed or could not be read
+
+# define RD_KEY_OFF	offsetof(rtpdir_T, rd_dir)
+# define HI2RD(hi)	((rtpdir_T *)((hi)->hi_key - RD_KEY_OFF))
+
+// A directory changed less than this number of seconds ago is not indexed,
+// another change in the same second would not change the mtime.
+# define RD_RACY_SECONDS 2
+
+static hashtab_T rtpdir_ht;
+static int	 rtpdir_ht_init = FALSE;
+
+/*
+ * Copy "name" to "buf" for use as a key in rd_names.  Returns FALSE when the
+ * name can't be used as a key.
+ */
+    static int
+rtpdir_name_key(char_u *name, int len, char_u *buf)
+{
+    int		i;
+
+    if (len >= MAXPATHL)
+	return FALSE;
+    for (i = 0; i < len; ++i)
+    {
+# ifdef CASE_INSENSITIVE_FILENAME
+	// Only ASCII case folding is done.
+	if (name[i] >= 0x80)
+	    return FALSE;
+	buf[i] = TOLOWER_ASC(name[i]);
+# else
+	buf[i] = name[i];
+# endif
+    }
+    buf[len] = NUL;
+    return TRUE;
+}
+
+/*
+ * Remove all names from the index of "rd".
+ */
+    static void
+rtpdir_clear_names(rtpdir_T *rd)
+{
+    hash_clear_all(&rd->rd_names, 0);
+    hash_init(&rd->rd_names);
+}
+
+/*
+ * Callback for readdir_core(): add "name" to the index.
+ */
+    static int
+rtpdir_add_name(void *context, char_u *name)
+{
+    rtpdir_T	*rd = context;
+    char_u	buf[MAXPATHL];
+    char_u	*key;
+    hash_T	hash;
+    hashitem_T	*hi;
+
+    if (!rtpdir_name_key(name, (int)STRLEN(name), buf))
+	// Can't look up this name, fall back to expanding patterns.
+	rd->rd_state = RD_UNKNOWN;
+    else
+    {
+	hash = hash_hash(buf);
+	hi = hash_lookup(&rd->rd_names, buf, hash);
+	if (HASHITEM_EMPTY(hi))
+	{
+	    key = vim_strsave(buf);
+	    if (key == NULL || hash_add_item(&rd->rd_names, hi, key, hash)
+								      == FAIL)
+	    {
+		vim_free(key);
+		rd->rd_state = RD_UNKNOWN;
+	    }
+	}
+    }
+    // Stop reading when the index can't be used.
+    return rd->rd_state == RD_INDEXED ? 0 : -1;
+}
+
+/*
+ * Get the index for directory "dir", which ends in a path separator.
+ * Reads the directory when it was not indexed yet or has changed.
+ * Returns NULL when the index can't be used for this directory.
+ */
+    static rtpdir_T *
+rtpdir_get(char_u *dir)
+{
+    rtpdir_T	*rd;
+    hashitem_T	*hi;
+    hash_T	hash;
+    stat_T	st;
+    garray_T	ga;
+
+    // A relative directory depends on the current directory and a pattern
+    // in the directory name needs to be expanded.
+    if (!mch_isFullName(dir) || mch_has_wildcard(dir))
+	return NULL;
+
+    if (!rtpdir_ht_init)
+    {
+	hash_init(&rtpdir_ht);
+	rtpdir_ht_init = TRUE;
+    }
+    hash = hash_hash(dir);
+    hi = hash_lookup(&rtpdir_ht, dir, hash);
+    if (HASHITEM_EMPTY(hi))
+    {
+	rd = alloc(sizeof(rtpdir_T) + STRLEN(dir));
+	if (rd == NULL)
+	    return NULL;
+	STRCPY(rd->rd_dir, dir);
+	rd->rd_state = RD_UNKNOWN;
+	rd->rd_mtime = 0;
+	hash_init(&rd->rd_names);
+	if (hash_add_item(&rtpdir_ht, hi, rd->rd_dir, hash) == FAIL)
+	{
+	    vim_free(rd);
+	    return NULL;
+	}
+    }
+    else
+	rd = HI2RD(hi);
+
+    if (mch_stat((char *)dir, &st) < 0 || !S_ISDIR(st.st_mode))
+    {
+	if (rd->rd_state == RD_INDEXED)
+	    rtpdir_clear_names(rd);
+	rd->rd_state = RD_MISSING;
+	return rd;
+    }
+    if (rd->rd_state == RD_INDEXED && rd->rd_mtime == st.st_mtime)
+	return rd;
+
+    if (rd->rd_state == RD_INDEXED)
+	rtpdir_clear_names(rd);
+    rd->rd_state = RD_UNKNOWN;
+    if (st.st_mtime > time(NULL) - RD_RACY_SECONDS)
+	return NULL;
+
+    rd->rd_state = RD_INDEXED;
+    rd->rd_mtime = st.st_mtime;
+    ++msg_silent;
+    if (readdir_core(&ga, dir, rd, rtpdir_add_name) == FAIL)
+	rd->rd_state = RD_UNKNOWN;
+    --msg_silent;
+    ga_clear_strings(&ga);
+    if (rd->rd_state != RD_INDEXED)
+    {
+	rtpdir_clear_names(rd);
+	return NULL;
+    }
+    return rd;
+}
+
+/*
+ * Return FALSE when pattern "pat" can't match anything in the directory of
+ * "rd", because the first path component doesn't exist there.
+ */
+    static int
+rtpdir_may_match(rtpdir_T *rd, char_u *pat)
+{
+    char_u	*p = pat;
+    char_u	buf[MAXPATHL];
+
+    if (rd->rd_state == RD_MISSING)
+	return FALSE;
+    while (*p != NUL && !vim_ispathsep(*p))
+    {
+	// A backslash escapes a character or is a path separator, can't tell
+	// what name it matches.
+	if (*p == '\\')
+	    return TRUE;
+	++p;
+    }
+    if (!rtpdir_name_key(pat, (int)(p - pat), buf)
+	    || *buf == NUL || mch_has_wildcard(buf)
+	    || STRCMP(buf, ".") == 0 || STRCMP(buf, "..") == 0)
+	return TRUE;
+    return !HASHITEM_EMPTY(hash_find(&rd->rd_names, buf));
+}
+
+# if defined(EXITFREE) || defined(PROTO)
+    void
+free_rtp_index(void)
+{
+    hashitem_T	*hi;
+    int		todo;
+
+    if (!rtpdir_ht_init)
+	return;
+    todo = (int)rtpdir_ht.ht_used;
+    for (hi = rtpdir_ht.ht_array; todo > 0; ++hi)
+	if (!HASHITEM_EMPTY(hi))
+	{
+	    rtpdir_T *rd = HI2RD(hi);
+
+	    hash_clear_all(&rd->rd_names, 0);
+	    vim_free(rd);
+	    --todo;
+	}
+    hash_clear(&rtpdir_ht);
+    rtpdir_ht_init = FALSE;
+}
+# endif
+#endif
+
 /*
  * Find the file "name" in all directories in "path" and invoke
  * "callback(fname, cookie)".
@@ -231,6 +458,9 @@ do_in_path(
     char_u	**files;
     int		i;
     int		did_one = FALSE;
+#if defined(TEMPDIRNAMES) || defined(FEAT_EVAL)
+    rtpdir_T	*rd;
+#endif
 #ifdef AMIGA
     struct Process	*proc = (struct Process *)FindTask(0L);
     APTR		save_winptr = proc->pr_WindowPtr;
@@ -284,6 +514,9 @@ do_in_path(
 	    {
 		add_pathsep(buf);
 		tail = buf + STRLEN(buf);
+#if defined(TEMPDIRNAMES) || defined(FEAT_EVAL)
+		rd = rtpdir_get(buf);
+#endif
 
 		// Loop over all patterns in "name"
 		np = name;
@@ -300,6 +533,11 @@ do_in_path(
 			verbose_leave();
 		    }
 
+#if defined(TEMPDIRNAMES) || defined(FEAT_EVAL)
+		    // Skip expanding when the first directory doesn't exist.
+		    if (rd != NULL && !rtpdir_may_match(rd, tail))
+			continue;
+#endif
 		    // Expand wildcards, invoke the callback for each match.
 		    if (gen_expand_wildcards(1, &buf, &num_files, &files,
 				  (flags & DIP_DIR) ? EW_DIR : EW_FILE) == OK)
@@ -450,29 +688,267 @@ source_all_matches(char_u *pat)
 }
 
 /*
- * Add the package directory to 'runtimepath'.
+ * An entry of 'runtimepath' while package directories are inserted in it.
+ * The entries are in a list, the new value of the option is built when all
+ * directories have been inserted.
+ */
+typedef struct rtpentry_S rtpentry_T;
+struct rtpentry_S
+{
+    rtpentry_T	*re_next;	// next entry in 'runtimepath'
+    rtpentry_T	*re_same;	// next entry with the same key
+    char_u	*re_text;	// text of the entry, including the separator
+    char_u	*re_name;	// entry name, as copy_option_part() gets it
+    char_u	*re_ffname;	// full name with a path separator or NULL
+    int		re_sep;		// "re_text" ends in a separator
+    int		re_addsep;	// a comma goes after "re_text"
+    int		re_after;	// this is an "after" directory
+    char_u	re_key[1];	// key in the hashtab, actually longer
+};
+
+# define RE_KEY_OFF	offsetof(rtpentry_T, re_key)
+# define HI2RE(hi)	((rtpentry_T *)((hi)->hi_key - RE_KEY_OFF))
+
+typedef struct
+{
+    rtpentry_T	*rl_first;	// first entry
+    rtpentry_T	*rl_last;	// last entry
+    rtpentry_T	*rl_nokey;	// entries without a key, linked with re_same
+    hashtab_T	rl_keys;	// entries by key, linked with re_same
+    int		rl_len;		// length of the option value
+} rtplist_T;
+
+/*
+ * Copy "name" to "buf" in a form where names that pathcmp() considers equal
+ * are the same: ignore trailing path separators and, when 'fileignorecase'
+ * is set, case.  Returns FALSE when that is not possible.
  */
     static int
-add_pack_dir_to_rtp(char_u *fname)
-{
-    char_u  *p4, *p3, *p2, *p1, *p;
-    char_u  *entry;
-    char_u  *insp = NULL;
-    int	    c;
-    char_u  *new_rtp;
-    int	    keep;
-    size_t  oldlen;
-    size_t  addlen;
-    size_t  new_rtp_len;
-    char_u  *afterdir = NULL;
-    size_t  afterlen = 0;
-    char_u  *after_insp = NULL;
-    char_u  *ffname = NULL;
-    size_t  fname_len;
-    char_u  *buf = NULL;
-    char_u  *rtp_ffname;
-    int	    match;
-    int	    retval = FAIL;
+rtpentry_key(char_u *name, char_u *buf)
+{
+    int	    len = (int)STRLEN(name);
+    int	    i;
+
+    while (len > 0 && vim_ispathsep(name[len - 1]))
+	--len;
+    if (len >= MAXPATHL)
+	return FALSE;
+    for (i = 0; i < len; ++i)
+    {
+	if (p_fic && name[i] >= 0x80)
+	    // MB_TOUPPER() would be needed.
+	    return FALSE;
+	buf[i] = p_fic ? TOLOWER_ASC(name[i]) : name[i];
+#ifdef BACKSLASH_IN_FILENAME
+	if (buf[i] == '\\')
+	    buf[i] = '/';
+#endif
+    }
+    buf[len] = NUL;
+    return TRUE;
+}
+
+/*
+ * Append an entry to "rl" with text "text[len]" and name "name".  Inserts it
+ * before "before" if that is not NULL.  "has_sep" is TRUE when "text" ends in
+ * a separator.  "buf" is used for the key.
+ * Returns the new entry, NULL when out of memory.
+ */
+    static rtpentry_T *
+rtplist_add(
+	rtplist_T   *rl,
+	char_u	    *text,
+	int	    len,
+	int	    has_sep,
+	char_u	    *name,
+	rtpentry_T  *before,
+	char_u	    *buf)
+{
+    rtpentry_T	*re;
+    rtpentry_T	**pp;
+    int		has_key = rtpentry_key(name, buf);
+    int		keylen = has_key ? (int)STRLEN(buf) : 0;
+    hash_T	hash;
+    hashitem_T	*hi;
+    char_u	*p;
+
+    re = alloc(sizeof(rtpentry_T) + keylen + STRLEN(name) + len + 2);
+    if (re == NULL)
+	return NULL;
+    mch_memmove(re->re_key, buf, keylen);
+    re->re_key[keylen] = NUL;
+    re->re_name = re->re_key + keylen + 1;
+    STRCPY(re->re_name, name);
+    re->re_text = re->re_name + STRLEN(name) + 1;
+    vim_strncpy(re->re_text, text, len);
+    re->re_ffname = NULL;
+    re->re_sep = has_sep;
+    re->re_addsep = FALSE;
+    rl->rl_len += len;
+
+    // Only the first "after" in the name counts, like it always did.
+    p = (char_u *)strstr((char *)name, "after");
+    re->re_after = p != NULL && p > name && vim_ispathsep(p[-1])
+		  && (vim_ispathsep(p[5]) || p[5] == NUL || p[5] == ',');
+
+    if (!has_key)
+    {
+	re->re_same = rl->rl_nokey;
+	rl->rl_nokey = re;
+    }
+    else
+    {
+	hash = hash_hash(re->re_key);
+	hi = hash_lookup(&rl->rl_keys, re->re_key, hash);
+	if (HASHITEM_EMPTY(hi))
+	{
+	    re->re_same = NULL;
+	    if (hash_add_item(&rl->rl_keys, hi, re->re_key, hash) == FAIL)
+	    {
+		vim_free(re);
+		return NULL;
+	    }
+	}
+	else
+	{
+	    re->re_same = HI2RE(hi)->re_same;
+	    HI2RE(hi)->re_same = re;
+	}
+    }
+
+    re->re_next = before;
+    if (before == NULL)
+    {
+	if (rl->rl_last == NULL)
+	    rl->rl_first = re;
+	else
+	    rl->rl_last->re_next = re;
+	rl->rl_last = re;
+    }
+    else
+    {
+	for (pp = &rl->rl_first; *pp != before; pp = &(*pp)->re_next)
+	    ;
+	*pp = re;
+    }
+    return re;
+}
+
+/*
+ * Insert a directory "name" in "rl", before entry "before" or at the end.
+ */
+    static int
+rtplist_insert(
+	rtplist_T   *rl,
+	char_u	    *name,
+	rtpentry_T  *before,
+	char_u	    *buf)
+{
+    char_u	*text;
+    char_u	*p;
+    int		len = (int)STRLEN(name);
+    rtpentry_T	*re;
+
+    if (before == NULL)
+    {
+	// Append: ",{name}".  After a separator the comma is an empty entry.
+	if (rl->rl_last == NULL || rl->rl_last->re_sep)
+	{
+	    if (rtplist_add(rl, (char_u *)",", 1, TRUE, (char_u *)"", NULL,
+							    buf + MAXPATHL) == NULL)
+		return FAIL;
+	}
+	else
+	{
+	    rl->rl_last->re_sep = TRUE;
+	    rl->rl_last->re_addsep = TRUE;
+	    ++rl->rl_len;
+	}
+	// Get the name back like copy_option_part() does when the option is
+	// used.
+	p = name;
+	copy_option_part(&p, buf, MAXPATHL, ",");
+	re = rtplist_add(rl, name, len, FALSE, buf, NULL, buf + MAXPATHL);
+	return re == NULL ? FAIL : OK;
+    }
+
+    // Insert: "{name},".
+    text = alloc(len + 2);
+    if (text == NULL)
+	return FAIL;
+    STRCPY(text, name);
+    STRCPY(text + len, ",");
+    p = text;
+    copy_option_part(&p, buf, MAXPATHL, ",");
+    re = rtplist_add(rl, text, len + 1, TRUE, buf, before, buf + MAXPATHL);
+    vim_free(text);
+    return re == NULL ? FAIL : OK;
+}
+
+/*
+ * Return TRUE if "name" is an entry in "rl".
+ */
+    static int
+rtplist_contains(rtplist_T *rl, char_u *name, char_u *buf)
+{
+    rtpentry_T	*re;
+    hashitem_T	*hi;
+
+    if (!rtpentry_key(name, buf))
+    {
+	for (re = rl->rl_first; re != NULL; re = re->re_next)
+	    if (pathcmp((char *)re->re_name, (char *)name, -1) == 0)
+		return TRUE;
+	return FALSE;
+    }
+
+    hi = hash_find(&rl->rl_keys, buf);
+    if (!HASHITEM_EMPTY(hi))
+	for (re = HI2RE(hi); re != NULL; re = re->re_same)
+	    if (pathcmp((char *)re->re_name, (char *)name, -1) == 0)
+		return TRUE;
+    for (re = rl->rl_nokey; re != NULL; re = re->re_same)
+	if (pathcmp((char *)re->re_name, (char *)name, -1) == 0)
+	    return TRUE;
+    return FALSE;
+}
+
+/*
+ * Free the entries of "rl".
+ */
+    static void
+rtplist_clear(rtplist_T *rl)
+{
+    rtpentry_T	*re;
+
+    while (rl->rl_first != NULL)
+    {
+	re = rl->rl_first;
+	rl->rl_first = re->re_next;
+	vim_free(re->re_ffname);
+	vim_free(re);
+    }
+    hash_clear(&rl->rl_keys);
+}
+
+/*
+ * Add the package directory "fname" to the entries in "rl": after the entry
+ * for the directory that contains "pack", and its "after" directory before
+ * the first "after" entry.
+ */
+    static int
+rtplist_add_pack_dir(rtplist_T *rl, char_u *fname, char_u *buf)
+{
+    char_u	*p4, *p3, *p2, *p1, *p;
+    int		c;
+    char_u	*ffname;
+    size_t	fname_len;
+    rtpentry_T	*re;
+    rtpentry_T	*insp = NULL;
+    rtpentry_T	*after_insp = NULL;
+    int		found = FALSE;
+    char_u	*afterdir;
+    int		retval = FAIL;
 
     p4 = p3 = p2 = p1 = get_past_head(fname);
     for (p = p1; *p; MB_PTR_ADV(p))
@@ -493,107 +969,139 @@ add_pack_dir_to_rtp(char_u *fname)
     if (ffname == NULL)
 	return FAIL;
 
-    // Find "ffname" in "p_rtp", ignoring '/' vs '\' differences.
+    // Find "ffname" in the entries, ignoring '/' vs '\' differences.
     // Also stop at the first "after" directory.
     fname_len = STRLEN(ffname);
-    buf = alloc(MAXPATHL);
-    if (buf == NULL)
-	goto theend;
-    for (entry = p_rtp; *entry != NUL; )
+    for (re = rl->rl_first; re != NULL; re = re->re_next)
     {
-	char_u *cur_entry = entry;
-
-	copy_option_part(&entry, buf, MAXPATHL, ",");
-	if (insp == NULL)
+	if (!found)
 	{
-	    add_pathsep(buf);
-	    rtp_ffname = fix_fname(buf);
-	    if (rtp_ffname == NULL)
-		goto theend;
-	    match = vim_fnamencmp(rtp_ffname, ffname, fname_len) == 0;
-	    vim_free(rtp_ffname);
-	    if (match)
-		// Insert "ffname" after this entry (and comma).
-		insp = entry;
+	    if (re->re_ffname == NULL)
+	    {
+		vim_strncpy(buf, re->re_name, MAXPATHL - 1);
+		add_pathsep(buf);
+		re->re_ffname = fix_fname(buf);
+		if (re->re_ffname == NULL)
+		    goto theend;
+	    }
+	    if (vim_fnamencmp(re->re_ffname, ffname, fname_len) == 0)
+	    {
+		// Insert "fname" after this entry.
+		insp = re->re_next;
+		found = TRUE;
+	    }
 	}
 
-	if ((p = (char_u *)strstr((char *)buf, "after")) != NULL
-		&& p > buf
-		&& vim_ispathsep(p[-1])
-		&& (vim_ispathsep(p[5]) || p[5] == NUL || p[5] == ','))
+	if (re->re_after)
 	{
-	    if (insp == NULL)
+	    if (!found)
+	    {
 		// Did not find "ffname" before the first "after" directory,
 		// insert it before this entry.
-		insp = cur_entry;
-	    after_insp = cur_entry;
+		insp = re;
+		found = TRUE;
+	    }
+	    after_insp = re;
 	    break;
 	}
     }
+    // When both "fname" and "after" were not found "insp" is NULL: append
+    // at the end.
 
-    if (insp == NULL)
-	// Both "fname" and "after" not found, append at the end.
-	insp = p_rtp + STRLEN(p_rtp);
+    if (rtplist_insert(rl, fname, insp, buf) == FAIL)
+	goto theend;
 
     // check if rtp/pack/name/start/name/after exists
     afterdir = concat_fnames(fname, (char_u *)"after", TRUE);
     if (afterdir != NULL && mch_isdir(afterdir))
-	afterlen = STRLEN(afterdir) + 1; // add one for comma
+	// Insert before the first "after" directory or append.
+	retval = rtplist_insert(rl, afterdir, after_insp, buf);
+    else
+	retval = OK;
+    vim_free(afterdir);
 
-    oldlen = STRLEN(p_rtp);
-    addlen = STRLEN(fname) + 1; // add one for comma
-    new_rtp = alloc(oldlen + addlen + afterlen + 1); // add one for NUL
-    if (new_rtp == NULL)
-	goto theend;
+theend:
+    vim_free(ffname);
+    return retval;
+}
 
-    // We now have 'rtp' parts: {keep}{keep_after}{rest}.
-    // Create new_rtp, first: {keep},{fname}
-    keep = (int)(insp - p_rtp);
-    mch_memmove(new_rtp, p_rtp, keep);
-    new_rtp_len = keep;
-    if (*insp == NUL)
-	new_rtp[new_rtp_len++] = ',';  // add comma before
-    mch_memmove(new_rtp + new_rtp_len, fname, addlen - 1);
-    new_rtp_len += addlen - 1;
-    if (*insp != NUL)
-	new_rtp[new_rtp_len++] = ',';  // add comma after
-
-    if (afterlen > 0 && after_insp != NULL)
-    {
-	int keep_after = (int)(after_insp - p_rtp);
-
-	// Add to new_rtp: {keep},{fname}{keep_after},{afterdir}
-	mch_memmove(new_rtp + new_rtp_len, p_rtp + keep,
-							keep_after - keep);
-	new_rtp_len += keep_after - keep;
-	mch_memmove(new_rtp + new_rtp_len, afterdir, afterlen - 1);
-	new_rtp_len += afterlen - 1;
-	new_rtp[new_rtp_len++] = ',';
-	keep = keep_after;
-    }
-
-    if (p_rtp[keep] != NUL)
-	// Append rest: {keep},{fname}{keep_after},{afterdir}{rest}
-	mch_memmove(new_rtp + new_rtp_len, p_rtp + keep, oldlen - keep + 1);
-    else
-	new_rtp[new_rtp_len] = NUL;
+/*
+ * Add the package directories "dirs[count]" to 'runtimepath', each one at the
+ * same place as when adding them one by one, skipping directories that are
+ * already in 'runtimepath'.  The option is set only once.
+ * Returns FAIL when out of memory.
+ */
+    static int
+add_pack_dirs_to_rtp(char_u **dirs, int count)
+{
+    rtplist_T	rl;
+    rtpentry_T	*re;
+    char_u	*entry;
+    char_u	*cur_entry;
+    char_u	*buf;
+    char_u	*new_rtp;
+    char_u	*p;
+    int		has_sep;
+    int		changed = FALSE;
+    int		i;
+    int		retval = FAIL;
 
-    if (afterlen > 0 && after_insp == NULL)
+    CLEAR_FIELD(rl);
+    hash_init(&rl.rl_keys);
+    // Room for a name and a key.
+    buf = alloc(MAXPATHL * 2);
+    if (buf == NULL)
+	return FAIL;
+
+    for (entry = p_rtp; *entry != NUL; )
     {
-	// Append afterdir when "after" was not found:
-	// {keep},{fname}{rest},{afterdir}
-	STRCAT(new_rtp, ",");
-	STRCAT(new_rtp, afterdir);
+	cur_entry = entry;
+	copy_option_part(&entry, buf, MAXPATHL, ",");
+	has_sep = *entry != NUL;
+	if (!has_sep)
+	{
+	    // The last entry may end in a comma.
+	    for (p = cur_entry; *p != NUL && *p != ','; ++p)
+		if (p[0] == '\\' && p[1] == ',')
+		    ++p;
+	    has_sep = *p == ',';
+	}
+	if (rtplist_add(&rl, cur_entry, (int)(entry - cur_entry), has_sep,
+					    buf, NULL, buf + MAXPATHL) == NULL)
+	    goto theend;
     }
 
-    set_option_value((char_u *)"rtp", 0L, new_rtp, 0);
-    vim_free(new_rtp);
+    for (i = 0; i < count; ++i)
+	if (!rtplist_contains(&rl, dirs[i], buf))
+	{
+	    // directory is not yet in 'runtimepath', add it
+	    if (rtplist_add_pack_dir(&rl, dirs[i], buf) == FAIL)
+		goto theend;
+	    changed = TRUE;
+	}
+
+    if (changed)
+    {
+	new_rtp = alloc(rl.rl_len + 1);
+	if (new_rtp == NULL)
+	    goto theend;
+	p = new_rtp;
+	for (re = rl.rl_first; re != NULL; re = re->re_next)
+	{
+	    STRCPY(p, re->re_text);
+	    p += STRLEN(p);
+	    if (re->re_addsep)
+		*p++ = ',';
+	}
+	*p = NUL;
+	set_option_value((char_u *)"rtp", 0L, new_rtp, 0);
+	vim_free(new_rtp);
+    }
     retval = OK;
 
 theend:
+    rtplist_clear(&rl);
     vim_free(buf);
-    vim_free(ffname);
-    vim_free(afterdir);
     return retval;
 }
 
@@ -649,43 +1157,56 @@ static int APP_BOTH;
     static void
 add_pack_plugin(char_u *fname, void *cookie)
 {
-    if (cookie != &APP_LOAD)
-    {
-	char_u	*buf = alloc(MAXPATHL);
-	char_u	*p;
-	int	found = FALSE;
+#ifdef STARTUPTIME
+    struct timeval	tv_rel;
+    struct timeval	tv_start;
+#endif
 
-	if (buf == NULL)
-	    return;
-	p = p_rtp;
-	while (*p != NUL)
+    if (cookie != &APP_LOAD && add_pack_dirs_to_rtp(&fname, 1) == FAIL)
+	return;
+
+    if (cookie != &APP_ADD_DIR)
+    {
+#ifdef STARTUPTIME
+	if (time_fd != NULL)
+	    time_push(&tv_rel, &tv_start);
+#endif
+	load_pack_plugin(fname);
+#ifdef STARTUPTIME
+	if (time_fd != NULL)
 	{
-	    copy_option_part(&p, buf, MAXPATHL, ",");
-	    if (pathcmp((char *)buf, (char *)fname, -1) == 0)
-	    {
-		found = TRUE;
-		break;
-	    }
+	    vim_snprintf((char *)IObuff, IOSIZE, "package %s", fname);
+	    time_msg((char *)IObuff, &tv_start);
+	    time_pop(&tv_rel);
 	}
-	vim_free(buf);
-	if (!found)
-	    // directory is not yet in 'runtimepath', add it
-	    if (add_pack_dir_to_rtp(fname) == FAIL)
-		return;
+#endif
     }
+}
 
-    if (cookie != &APP_ADD_DIR)
-	load_pack_plugin(fname);
+/*
+ * Callback for do_in_path(): add "fname" to the growarray "cookie".
+ */
+    static void
+add_pack_dir_to_list(char_u *fname, void *cookie)
+{
+    ga_add_string((garray_T *)cookie, fname);
 }
 
 /*
  * Add all packages in the "start" directory to 'runtimepath'.
+ * The directories are found first, so that the option is set only once.
  */
     void
 add_pack_start_dirs(void)
 {
+    garray_T	ga;
+
+    ga_init2(&ga, (int)sizeof(char_u *), 50);
     do_in_path(p_pp, (char_u *)"pack/*/start/*", DIP_ALL + DIP_DIR,
-					       add_pack_plugin, &APP_ADD_DIR);
+						   add_pack_dir_to_list, &ga);
+    if (ga.ga_len > 0)
+	(void)add_pack_dirs_to_rtp((char_u **)ga.ga_data, ga.ga_len);
+    ga_clear_strings(&ga);
 }
 
 /*
@@ -1007,6 +1528,10 @@ ex_options(
 struct source_cookie
 {
     FILE	*fp;		// opened file for sourcing
+    char_u	*text;		// contents of the file, NULL when reading
+				// lines from "fp"
+    long	text_len;	// length of "text"
+    long	text_idx;	// index in "text" of the next line
     char_u	*nextline;	// if not NULL: line that was read ahead
     linenr_T	sourcing_lnum;	// line number of the source file
     int		finished;	// ":finish" used
@@ -1082,6 +1607,64 @@ fopen_noinh_readbin(char *filename)
 }
 #endif
 
+/*
+ * Get the contents of the file opened as "sp->fp" in "sp->text", so that
+ * lines can be taken from memory instead of reading them one by one.  When
+ * "si" is not NULL and has the text of the unchanged file it is taken from
+ * there.  "st" is set to the file info.
+ * Leaves "sp->text" NULL when the file is not a regular file or reading
+ * fails, then lines are read with fgets().
+ */
+    static void
+source_get_text(
+	struct source_cookie	*sp,
+	scriptitem_T		*si UNUSED,
+	stat_T			*st)
+{
+    long	len;
+
+    if (mch_fstat(fileno(sp->fp), st) < 0 || !S_ISREG(st->st_mode))
+	return;
+    len = (long)st->st_size;
+    if ((off_T)len != st->st_size || len >= LONG_MAX)
+	return;
+
+#ifdef FEAT_EVAL
+    if (si != NULL && si->sn_text != NULL)
+    {
+	// A file changed in the second it was read or the one before may
+	// change again without a different mtime, then it must be read again.
+	if (si->sn_text_len == len && si->sn_text_mtime == st->st_mtime
+		&& si->sn_text_mtime < si->sn_text_time - 1
+# ifdef UNIX
+		&& si->sn_text_ino == st->st_ino
+# endif
+		)
+	{
+	    // Borrow the text, do_source() puts it back when done.
+	    sp->text = si->sn_text;
+	    sp->text_len = len;
+	    si->sn_text = NULL;
+	    return;
+	}
+	VIM_CLEAR(si->sn_text);
+    }
+#endif
+
+    sp->text = alloc(len + 1);
+    if (sp->text == NULL)
+	return;
+    if (len > 0 && (long)fread(sp->text, 1, (size_t)len, sp->fp) != len)
+    {
+	// Something went wrong, start again with reading lines.
+	VIM_CLEAR(sp->text);
+	rewind(sp->fp);
+	return;
+    }
+    sp->text[len] = NUL;
+    sp->text_len = len;
+}
+
 /*
  * do_source: Read the file "fname" and execute its lines as EX commands.
  * When "ret_sid" is not NULL and we loaded the script before, don't load it
@@ -1104,7 +1687,9 @@ do_source(
     char_u		    *fname_exp;
     char_u		    *firstline = NULL;
     int			    retval = FAIL;
+    stat_T		    st;
 #ifdef FEAT_EVAL
+    time_t		    text_time;
     sctx_T		    save_current_sctx;
     static scid_T	    last_current_SID = 0;
     static int		    last_current_SID_seq = 0;
@@ -1251,6 +1836,15 @@ do_source(
     cookie.sourcing_lnum = 0;
     cookie.finished = FALSE;
 
+    cookie.text = NULL;
+    cookie.text_idx = 0;
+#ifdef FEAT_EVAL
+    text_time = time(NULL);
+    source_get_text(&cookie, sid > 0 ? si : NULL, &st);
+#else
+    source_get_text(&cookie, NULL, &st);
+#endif
+
 #ifdef FEAT_EVAL
     // Check if this script has a breakpoint.
     cookie.breakpoint = dbg_find_breakpoint(TRUE, fname_exp, (linenr_T)0);
@@ -1454,6 +2048,21 @@ do_source(
 almosttheend:
     // Get "si" again, "script_items" may have been reallocated.
     si = SCRIPT_ITEM(current_sctx.sc_sid);
+
+    // Keep the text of a script that is sourced again, it is likely to be
+    // sourced more often, e.g. a filetype plugin.
+    if (sid > 0 && cookie.text != NULL && si->sn_text == NULL)
+    {
+	si->sn_text = cookie.text;
+	si->sn_text_len = cookie.text_len;
+	si->sn_text_mtime = st.st_mtime;
+	si->sn_text_time = text_time;
+# ifdef UNIX
+	si->sn_text_ino = st.st_ino;
+# endif
+	cookie.text = NULL;
+    }
+
     if (si->sn_save_cpo != NULL)
     {
 	free_string_option(p_cpo);
@@ -1469,6 +2078,7 @@ almosttheend:
 # endif
 #endif
     fclose(cookie.fp);
+    vim_free(cookie.text);
     vim_free(cookie.nextline);
     vim_free(firstline);
     convert_setup(&cookie.conv, NULL, NULL);
@@ -1561,6 +2171,7 @@ free_scriptnames(void)
 	vim_free(si->sn_vars);
 
 	vim_free(si->sn_name);
+	vim_free(si->sn_text);
 	free_imports(i);
 	free_string_option(si->sn_save_cpo);
 #  ifdef FEAT_PROFILE
@@ -1600,21 +2211,44 @@ get_one_sourceline(struct source_cookie *sp)
 #endif
     int			have_read = FALSE;
 
-    // use a growarray to store the sourced line
-    ga_init2(&ga, 1, 250);
+    // use a growarray to store the sourced line, when taking it from the
+    // text it is allocated with the right size
+    ga_init2(&ga, 1, sp->text != NULL ? 1 : 250);
 
     // Loop until there is a finished line (or end-of-file).
     ++sp->sourcing_lnum;
     for (;;)
     {
-	// make room to read at least 120 (more) characters
-	if (ga_grow(&ga, 120) == FAIL)
-	    break;
-	buf = (char_u *)ga.ga_data;
+	if (sp->text != NULL)
+	{
+	    char_u  *s = sp->text + sp->text_idx;
+	    char_u  *nl;
+	    long    n = sp->text_len - sp->text_idx;
+
+	    // Take the next line from the text, including the NL.
+	    if (n <= 0)
+		break;
+	    nl = memchr(s, '\n', (size_t)n);
+	    if (nl != NULL)
+		n = (long)(nl - s) + 1;
+	    if (n >= INT_MAX - ga.ga_len || ga_grow(&ga, (int)n + 1) == FAIL)
+		break;
+	    buf = (char_u *)ga.ga_data;
+	    mch_memmove(buf + ga.ga_len, s, (size_t)n);
+	    buf[ga.ga_len + n] = NUL;
+	    sp->text_idx += n;
+	}
+	else
+	{
+	    // make room to read at least 120 (more) characters
+	    if (ga_grow(&ga, 120) == FAIL)
+		break;
+	    buf = (char_u *)ga.ga_data;
 
-	if (fgets((char *)buf + ga.ga_len, ga.ga_maxlen - ga.ga_len,
+	    if (fgets((char *)buf + ga.ga_len, ga.ga_maxlen - ga.ga_len,
 							      sp->fp) == NULL)
-	    break;
+		break;
+	}
 	len = ga.ga_len + (int)STRLEN(buf + ga.ga_len);
 #ifdef USE_CRNL
 	// Ignore a trailing CTRL-Z, when in Dos mode.	Only recognize the
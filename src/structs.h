@@ -489,6 +489,7 @@ typedef struct mf_hashtab_S
  * The used blocks are also kept in hash lists.
  *
  * The used list is a doubly linked list, most recently used block first.
+ *	Blocks read by a sequential scan are put at the end until used again.
  *	The blocks in the used list have a block of memory allocated.
  *	mf_used_count is the number of pages in the used list.
  * The hash lists are used to quickly find a block in the used list.
@@ -509,7 +510,8 @@ struct block_hdr
 
 #define BH_DIRTY    1
 #define BH_LOCKED   2
-    char	bh_flags;	    // BH_DIRTY or BH_LOCKED
+#define BH_SCAN	    4		    // only read by a sequential scan
+    char	bh_flags;	    // BH_DIRTY, BH_LOCKED or BH_SCAN
 };
 
 /*
@@ -665,6 +667,11 @@ struct memfile
     blocknr_T	mf_infile_count;	// number of pages in the file
     unsigned	mf_page_size;		// number of bytes in a page
     int		mf_dirty;		// TRUE if there are dirty blocks
+    blocknr_T	mf_scan_next;		// block after the last one read
+    int		mf_scan_count;		// number of blocks read in sequence
+    blocknr_T	mf_readahead;		// end of pages requested to read ahead
+    long	mf_hit_count;		// mf_get() found the block in memory
+    long	mf_miss_count;		// mf_get() read the block from the file
 #ifdef FEAT_CRYPT
     buf_T	*mf_buffer;		// buffer this memfile is for
     char_u	mf_seed[MF_SEED_LEN];	// seed for encryption
@@ -739,6 +746,9 @@ typedef struct memline
     chunksize_T *ml_chunksize;
     int		ml_numchunks;
     int		ml_usedchunks;
+    chunksize_T *ml_chunktree;	    // Fenwick tree over ml_chunksize
+    int		ml_chunktree_len;   // allocated entries in ml_chunktree
+    int		ml_chunktree_valid; // ml_chunktree matches ml_chunksize
 #endif
 } memline_T;
 
@@ -1231,6 +1241,10 @@ typedef struct hashitem_S
 // This allows for storing 10 items (2/3 of 16) before a resize is needed.
 #define HT_INIT_SIZE 16
 
+// Number of control bytes checked at once by a lookup.  Must not be more
+// than HT_INIT_SIZE.
+#define HT_GROUP_SIZE 16
+
 typedef struct hashtable_S
 {
     long_u	ht_mask;	// mask used for hash value (nr of items in
@@ -1240,9 +1254,16 @@ typedef struct hashtable_S
     int		ht_locked;	// counter for hash_lock()
     int		ht_error;	// when set growing failed, can't add more
 				// items before growing works
+    long_u	ht_changed;	// stamp, changes when an item is added or
+				// removed or the array is reallocated
     hashitem_T	*ht_array;	// points to the array, allocated when it's
 				// not "ht_smallarray"
+    char_u	*ht_ctrl;	// control byte for each item in "ht_array",
+				// followed by a copy of the first
+				// HT_GROUP_SIZE - 1; in the same allocation as
+				// "ht_array" or "ht_smallctrl"
     hashitem_T	ht_smallarray[HT_INIT_SIZE];   // initial array
+    char_u	ht_smallctrl[HT_INIT_SIZE + HT_GROUP_SIZE - 1];
 } hashtab_T;
 
 typedef long_u hash_T;		// Type for hi_hash
@@ -1326,6 +1347,9 @@ typedef struct cbq_S cbq_T;
 typedef struct channel_S channel_T;
 typedef struct cctx_S cctx_T;
 
+// The types up to VAR_FLOAT never need to be freed, the Vim9 instructions
+// ISN_LOADSCALAR and ISN_STORESCALAR check for "v_type <= VAR_FLOAT".  Keep
+// these first when adding a type.
 typedef enum
 {
     VAR_UNKNOWN = 0,	// not set, any type or "void" allowed
@@ -1438,6 +1462,9 @@ struct listvar_S
 	    int		lv_idx;		// cached index of an item
 	} mat;
     } lv_u;
+    listitem_T	**lv_index;	// when not NULL: pointers to all the items,
+				// for indexing; see list_find()
+    int		lv_index_size;	// number of entries allocated in "lv_index"
     list_T	*lv_copylist;	// copied list used by deepcopy()
     list_T	*lv_used_next;	// next list in used lists list
     list_T	*lv_used_prev;	// previous list in used lists list
@@ -1708,6 +1735,15 @@ typedef struct
     int		sn_had_command;	// TRUE if any command was executed
     char_u	*sn_save_cpo;	// 'cpo' value when :vim9script found
 
+    // Text of the script kept for sourcing it again, see do_source().
+    char_u	*sn_text;	// file contents or NULL
+    long	sn_text_len;	// length of sn_text
+    time_t	sn_text_mtime;	// mtime of the file when it was read
+    time_t	sn_text_time;	// time when the file was read
+# ifdef UNIX
+    ino_t	sn_text_ino;	// inode of the file
+# endif
+
 # ifdef FEAT_PROFILE
     int		sn_prof_on;	// TRUE when script is/was profiled
     int		sn_pr_force;	// forceit: profile functions in this script
@@ -1933,6 +1969,17 @@ struct jsonq_S
     int		jq_no_callback; // TRUE when no callback was found
 };
 
+// State of json_scan(), finding the end of a JSON message that is received
+// in parts.
+typedef struct {
+    long_u	jsc_used;	// number of bytes scanned
+    int		jsc_depth;	// nesting depth of [] and {}
+    int		jsc_quote;	// quote of the string being scanned or NUL
+    int		jsc_escape;	// TRUE after a backslash in a string
+    int		jsc_done;	// TRUE when the end was found
+    int		jsc_fail;	// TRUE when the end can't be found this way
+} json_scan_T;
+
 struct cbq_S
 {
     callback_T	cq_callback;
@@ -1985,6 +2032,10 @@ typedef struct {
 # if defined(UNIX) && !defined(HAVE_SELECT)
     int		ch_poll_idx;	// used by channel_poll_setup()
 # endif
+# ifdef USE_EPOLL
+    int		ch_epoll_state;	    // EPOLL_NONE, EPOLL_WATCH or EPOLL_POLL
+    channel_T	*ch_epoll_channel;  // channel this part belongs to
+# endif
 
 #ifdef FEAT_GUI_X11
     XtInputId	ch_inputHandler; // Cookie for input
@@ -2009,6 +2060,9 @@ typedef struct {
     // message when the deadline was set.  If it gets longer (something was
     // received) the deadline is reset.
     size_t	ch_wait_len;
+    json_scan_T	ch_json_scan;	// how far the message in "ch_head" was
+				// checked to be complete, only set for JSON
+				// and JS mode
 #ifdef MSWIN
     DWORD	ch_deadline;
 #else
@@ -2391,6 +2445,8 @@ typedef struct {
      * b_sst_freecount	number of free entries in b_sst_array[]
      * b_sst_check_lnum	entries after this lnum need to be checked for
      *			validity (MAXLNUM means no check needed)
+     * b_sst_idle_lnum	lines before this were parsed while waiting for
+     *			the user to type a character
      */
     synstate_T	*b_sst_array;
     int		b_sst_len;
@@ -2399,6 +2455,7 @@ typedef struct {
     int		b_sst_freecount;
     linenr_T	b_sst_check_lnum;
     short_u	b_sst_lasttick;	// last display tick
+    linenr_T	b_sst_idle_lnum;
 #endif // FEAT_SYN_HL
 
 #ifdef FEAT_SPELL
@@ -287,6 +287,7 @@ static int syn_match_linecont(linenr_T lnum);
 static void syn_start_line(void);
 static void syn_update_ends(int startofline);
 static void syn_stack_alloc(void);
+static int syn_stack_lnum_displayed(linenr_T lnum);
 static int syn_stack_cleanup(void);
 static void syn_stack_free_entry(synblock_T *block, synstate_T *p);
 static synstate_T *syn_stack_find_entry(linenr_T lnum);
@@ -544,6 +545,58 @@ syntax_start(win_T *wp, linenr_T lnum)
     syn_start_line();
 }
 
+#if defined(FEAT_RELTIME) || defined(PROTO)
+/*
+ * Called while waiting for a character to be typed: Parse lines in the
+ * current window that have not been parsed yet, storing the state every so
+ * many lines.  Stops after a short time, the next call continues where this
+ * one stopped.
+ * Returns TRUE when there are more lines to parse.
+ */
+    int
+syn_idle_parse(void)
+{
+    win_T	*wp = curwin;
+    synblock_T	*block = wp->w_s;
+    linenr_T	line_count = wp->w_buffer->b_ml.ml_line_count;
+    linenr_T	lnum;
+    proftime_T	tm;
+    proftime_T	syntax_tm;
+
+    // Only when the window was displayed and the changes were applied to
+    // the saved states.
+    if (!syntax_present(wp) || block->b_syn_error || block->b_syn_slow
+	    || block->b_sst_array == NULL
+	    || wp->w_buffer->b_mod_set
+	    || must_redraw != 0
+	    || block->b_sst_idle_lnum >= line_count)
+	return FALSE;
+
+    profile_setlimit(SST_IDLE_MSEC, &tm);
+    profile_setlimit(p_rdt, &syntax_tm);
+    syn_set_timeout(&syntax_tm);
+    while (block->b_sst_idle_lnum < line_count)
+    {
+	lnum = block->b_sst_idle_lnum + SST_IDLE_LINES;
+	if (lnum > line_count)
+	    lnum = line_count;
+	syntax_start(wp, lnum);
+	if (got_int || block->b_syn_slow)
+	{
+	    // The current state is wrong after an interrupt.
+	    invalidate_current_state();
+	    break;
+	}
+	block->b_sst_idle_lnum = lnum;
+	if (profile_passed_limit(&tm))
+	    break;
+    }
+    syn_set_timeout(NULL);
+    return !got_int && !block->b_syn_slow
+				       && block->b_sst_idle_lnum < line_count;
+}
+#endif
+
 /*
  * We cannot simply discard growarrays full of state_items or buf_states; we
  * have to manually release their extmatch pointers first.
@@ -1038,6 +1091,12 @@ syn_update_ends(int startofline)
  * entries depends on the number of lines in the buffer.  For small buffers
  * the distance is fixed at SST_DIST, for large buffers there is a fixed
  * number of entries SST_MAX_ENTRIES, and the distance is computed.
+ *
+ * While waiting for the user to type a character, syn_idle_parse() parses the
+ * lines of the current window that were not parsed yet, a few at a time, to
+ * fill the entries for every so many lines.  Then jumping to the end of a
+ * long buffer only needs to parse from a nearby entry.  b_sst_idle_lnum
+ * remembers how far this got, changes in the buffer move it back.
  */
 
     static void
@@ -1053,6 +1112,7 @@ syn_stack_free_block(synblock_T *block)
 	block->b_sst_first = NULL;
 	block->b_sst_len = 0;
     }
+    block->b_sst_idle_lnum = 0;
 }
 /*
  * Free b_sst_array[] for buffer "buf".
@@ -1182,6 +1242,10 @@ syn_stack_apply_changes_block(synblock_T *block, buf_T *buf)
     synstate_T	*p, *prev, *np;
     linenr_T	n;
 
+    // Parsing while idle needs to be done again from the change.
+    if (block->b_sst_idle_lnum > buf->b_mod_top)
+	block->b_sst_idle_lnum = buf->b_mod_top;
+
     prev = NULL;
     for (p = block->b_sst_first; p != NULL; )
     {
@@ -1221,8 +1285,27 @@ syn_stack_apply_changes_block(synblock_T *block, buf_T *buf)
     }
 }
 
+/*
+ * Return TRUE if line "lnum" is displayed in a window that uses the state
+ * stack of syn_block.  The entries for these lines are kept, otherwise
+ * windows showing different parts of a buffer would remove each other's
+ * entries and need to parse again.
+ */
+    static int
+syn_stack_lnum_displayed(linenr_T lnum)
+{
+    win_T	*wp;
+
+    FOR_ALL_WINDOWS(wp)
+	if (wp->w_s == syn_block
+		&& lnum >= wp->w_topline && lnum < wp->w_botline)
+	    return TRUE;
+    return FALSE;
+}
+
 /*
  * Reduce the number of entries in the state stack for syn_buf.
+ * Entries for lines displayed in a window are not removed.
  * Returns TRUE if at least one entry was freed.
  */
     static int
@@ -1253,7 +1336,8 @@ syn_stack_cleanup(void)
     prev = syn_block->b_sst_first;
     for (p = prev->sst_next; p != NULL; prev = p, p = p->sst_next)
     {
-	if (prev->sst_lnum + dist > p->sst_lnum)
+	if (prev->sst_lnum + dist > p->sst_lnum
+				       && !syn_stack_lnum_displayed(p->sst_lnum))
 	{
 	    if (p->sst_tick > syn_block->b_sst_lasttick)
 	    {
@@ -1273,7 +1357,8 @@ syn_stack_cleanup(void)
     prev = syn_block->b_sst_first;
     for (p = prev->sst_next; p != NULL; prev = p, p = p->sst_next)
     {
-	if (p->sst_tick == tick && prev->sst_lnum + dist > p->sst_lnum)
+	if (p->sst_tick == tick && prev->sst_lnum + dist > p->sst_lnum
+				       && !syn_stack_lnum_displayed(p->sst_lnum))
 	{
 	    // Move this entry from used list to free list
 	    prev->sst_next = p->sst_next;
@@ -2466,34 +2466,179 @@ termcapinit(char_u *name)
 
 /*
  * The number of calls to ui_write is reduced by using "out_buf".
+ * While redrawing the screen "out_buf" grows instead of being flushed when it
+ * is full, so that the whole frame is written at once.  See out_frame_start().
  */
 #define OUT_SIZE	2047
+#define OUT_FRAME_SIZE	(256 * 1024 - 1)    // maximum size in a frame
 
 // add one to allow mch_write() in os_win32.c to append a NUL
-static char_u		out_buf[OUT_SIZE + 1];
+static char_u		out_buf_init[OUT_SIZE + 1];
+static char_u		*out_buf = out_buf_init;
+static int		out_size = OUT_SIZE;	// size of out_buf minus one
 
 static int		out_pos = 0;	// number of chars in out_buf
 
+static int		out_frame = FALSE;  // inside a frame
+static int		out_sync_start;	    // out_pos before T_BSU
+static int		out_sync_pos = -1;  // out_pos after T_BSU or -1
+static long		out_frame_bytes = 0;  // bytes written in the frame
+static long		out_frame_writes = 0; // ui_write() calls in the frame
+
+// Number of bytes the buffer can hold before it must be flushed.
+#define OUT_LIMIT	(out_frame ? out_size : OUT_SIZE)
+
 // Since the maximum number of SGR parameters shown as a normal value range is
 // 16, the escape sequence length can be 4 * 16 + lead + tail.
 #define MAX_ESC_SEQ_LEN	80
 
+/*
+ * Start a frame: until the next out_flush() the output is collected in one
+ * buffer, which is written with a single ui_write().  Also sends t_BS, if
+ * set, so that the terminal shows the frame at once.
+ * Not used for the GUI or with 'writedelay'.
+ */
+    void
+out_frame_start(void)
+{
+    if (out_frame || !full_screen || !termcap_active || p_wd > 0
+#ifdef FEAT_GUI
+	    || gui.in_use
+#endif
+	    )
+	return;
+    out_frame = TRUE;
+    out_frame_bytes = 0;
+    out_frame_writes = 0;
+    if (*T_BSU != NUL && *T_ESU != NUL)
+    {
+	int	start = out_pos;
+
+	out_str(T_BSU);
+	if (out_frame)
+	{
+	    out_sync_start = start;
+	    out_sync_pos = out_pos;
+	}
+    }
+}
+
+/*
+ * Make "out_buf" bigger while in a frame.
+ * Returns FAIL when it can't grow, the caller must flush then.
+ */
+    static int
+out_buf_grow(void)
+{
+    int	    new_size;
+    char_u  *p;
+
+    if (out_size >= OUT_FRAME_SIZE)
+	return FAIL;
+    new_size = out_size * 2 + 1;
+    if (new_size > OUT_FRAME_SIZE)
+	new_size = OUT_FRAME_SIZE;
+    if (out_buf == out_buf_init)
+    {
+	p = alloc(new_size + 1);
+	if (p != NULL)
+	    mch_memmove(p, out_buf, (size_t)out_pos);
+    }
+    else
+	p = vim_realloc(out_buf, new_size + 1);
+    if (p == NULL)
+	return FAIL;
+    out_buf = p;
+    out_size = new_size;
+    return OK;
+}
+
+/*
+ * Called when "out_buf" is (almost) full: make it bigger when in a frame,
+ * otherwise flush it.
+ */
+    static void
+out_buf_full(void)
+{
+    if (out_frame && out_buf_grow() == OK)
+	return;
+    out_flush();
+}
+
+/*
+ * Write "len" bytes of "out_buf" and count them for the frame.
+ */
+    static void
+out_write(int len)
+{
+    out_frame_bytes += len;
+    ++out_frame_writes;
+    ui_write(out_buf, len);
+}
+
 /*
  * out_flush(): flush the output buffer
+ * This also ends a frame.
  */
     void
 out_flush(void)
 {
     int	    len;
+    int	    end_frame = out_frame;
+
+    if (end_frame)
+    {
+	out_frame = FALSE;
+	if (out_sync_pos >= 0)
+	{
+	    len = (int)STRLEN(T_ESU);
+	    if (out_pos == out_sync_pos)
+		// nothing was drawn, drop t_BS
+		out_pos = out_sync_start;
+	    else if (out_pos + len <= out_size)
+	    {
+		mch_memmove(out_buf + out_pos, T_ESU, (size_t)len);
+		out_pos += len;
+	    }
+	    else
+	    {
+		// The buffer is full, write it and t_ES separately.
+		len = out_pos;
+		out_pos = 0;
+		out_write(len);
+		out_str_nf(T_ESU);
+	    }
+	    out_sync_pos = -1;
+	}
+    }
 
     if (out_pos != 0)
     {
 	// set out_pos to 0 before ui_write, to avoid recursiveness
 	len = out_pos;
 	out_pos = 0;
-	ui_write(out_buf, len);
+	out_write(len);
+    }
+    if (end_frame)
+    {
+	term_frame_bytes = out_frame_bytes;
+	term_frame_writes = out_frame_writes;
+    }
+}
+
+#if defined(EXITFREE) || defined(PROTO)
+    void
+free_out_buf(void)
+{
+    out_flush();
+    if (out_buf != out_buf_init)
+    {
+	vim_free(out_buf);
+	out_buf = out_buf_init;
+	out_size = OUT_SIZE;
     }
 }
+#endif
 
 /*
  * out_flush_cursor(): flush the output buffer and redraw the cursor.
@@ -2504,6 +2649,7 @@ out_flush_cursor(
     int	    force UNUSED,   // when TRUE, update cursor even when not moved
     int	    clear_selection UNUSED) // clear selection under cursor
 {
+    screen_flush_clear();
     mch_disable_flush();
     out_flush();
     mch_enable_flush();
@@ -2524,8 +2670,8 @@ out_flush_cursor(
     void
 out_flush_check(void)
 {
-    if (enc_dbcs != 0 && out_pos >= OUT_SIZE - MB_MAXBYTES)
-	out_flush();
+    if (enc_dbcs != 0 && out_pos >= OUT_LIMIT - MB_MAXBYTES)
+	out_buf_full();
 }
 
 #ifdef FEAT_GUI
@@ -2556,8 +2702,10 @@ out_char(unsigned c)
     out_buf[out_pos++] = c;
 
     // For testing we flush each time.
-    if (out_pos >= OUT_SIZE || p_wd)
+    if (p_wd)
 	out_flush();
+    else if (out_pos >= OUT_LIMIT)
+	out_buf_full();
 }
 
 /*
@@ -2568,8 +2716,8 @@ out_char_nf(unsigned c)
 {
     out_buf[out_pos++] = c;
 
-    if (out_pos >= OUT_SIZE)
-	out_flush();
+    if (out_pos >= OUT_LIMIT)
+	out_buf_full();
 }
 
 /*
@@ -2585,8 +2733,8 @@ out_char_nf(unsigned c)
 out_str_nf(char_u *s)
 {
     // avoid terminal strings being split up
-    if (out_pos > OUT_SIZE - MAX_ESC_SEQ_LEN)
-	out_flush();
+    if (out_pos > OUT_LIMIT - MAX_ESC_SEQ_LEN)
+	out_buf_full();
 
     while (*s)
 	out_char_nf(*s++);
@@ -2619,8 +2767,8 @@ out_str_cf(char_u *s)
 	    return;
 	}
 #endif
-	if (out_pos > OUT_SIZE - MAX_ESC_SEQ_LEN)
-	    out_flush();
+	if (out_pos > OUT_LIMIT - MAX_ESC_SEQ_LEN)
+	    out_buf_full();
 #ifdef HAVE_TGETENT
 	for (p = s; *s; ++s)
 	{
@@ -2687,8 +2835,8 @@ out_str(char_u *s)
 	}
 #endif
 	// avoid terminal strings being split up
-	if (out_pos > OUT_SIZE - MAX_ESC_SEQ_LEN)
-	    out_flush();
+	if (out_pos > OUT_LIMIT - MAX_ESC_SEQ_LEN)
+	    out_buf_full();
 #ifdef HAVE_TGETENT
 	tputs((char *)s, 1, TPUTSFUNCAST out_char_nf);
 #else
@@ -3539,6 +3687,7 @@ starttermcap(void)
     void
 stoptermcap(void)
 {
+    screen_flush_clear();
     screen_stop_highlight();
     reset_cterm_colors();
     if (termcap_active)
@@ -3771,7 +3920,11 @@ cursor_on_force(void)
 cursor_on(void)
 {
     if (cursor_is_off)
+    {
+	// Finish the screen before showing the cursor.
+	screen_flush_clear();
 	cursor_on_force();
+    }
 }
 
 /*
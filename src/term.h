@@ -107,10 +107,12 @@ enum SpecialKey
     KS_CST,	// save window title
     KS_CRT,	// restore window title
     KS_SSI,	// save icon text
-    KS_SRI	// restore icon text
+    KS_SRI,	// restore icon text
+    KS_BSU,	// begin synchronized update
+    KS_ESU	// end synchronized update
 };
 
-#define KS_LAST	    KS_SRI
+#define KS_LAST	    KS_ESU
 
 /*
  * the terminal capabilities are stored in this array
@@ -208,6 +210,8 @@ extern char_u *(term_strings[]);    // current terminal strings
 #define T_CRT	(TERM_STR(KS_CRT))	// restore window title
 #define T_SSI	(TERM_STR(KS_SSI))	// save icon text
 #define T_SRI	(TERM_STR(KS_SRI))	// restore icon text
+#define T_BSU	(TERM_STR(KS_BSU))	// begin synchronized update
+#define T_ESU	(TERM_STR(KS_ESU))	// end synchronized update
 
 typedef enum {
     TMODE_COOK,	    // terminal mode for external cmds and Ex mode
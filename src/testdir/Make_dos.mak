@@ -107,9 +107,11 @@ nolog:
 	-if exist test_result.log del test_result.log
 	-if exist messages del messages
 
-benchmark: test_bench_regexp.res
+SCRIPTS_BENCH = test_bench_regexp.res test_bench_vim9.res test_bench_json.res
 
-test_bench_regexp.res: test_bench_regexp.vim
+benchmark: $(SCRIPTS_BENCH)
+
+$(SCRIPTS_BENCH): $$(@B).vim
 	-if exist benchmark.out del benchmark.out
 	@echo $(VIMPROG) > vimcmd
 	$(VIMPROG) -u NONE $(NO_INITS) -S runtest.vim $*.vim
@@ -35,7 +35,7 @@ include Make_all.mak
 
 SCRIPTS = $(SCRIPTS_ALL) $(SCRIPTS_MORE1) $(SCRIPTS_MORE4) $(SCRIPTS_WIN32)
 
-SCRIPTS_BENCH = test_bench_regexp.res
+SCRIPTS_BENCH = test_bench_regexp.res test_bench_vim9.res test_bench_json.res
 
 # Must run test1 first to create small.vim.
 $(SCRIPTS) $(SCRIPTS_GUI) $(SCRIPTS_WIN32) $(NEW_TESTS_RES): $(SCRIPTS_FIRST)
@@ -110,7 +110,7 @@ nolog:
 	-@if exist test.log $(DEL) test.log
 	-@if exist messages $(DEL) messages
 
-test_bench_regexp.res: test_bench_regexp.vim
+$(SCRIPTS_BENCH): %.res: %.vim
 	-$(DEL) benchmark.out
 	@echo $(VIMPROG) > vimcmd
 	$(VIMPROG) -u NONE $(NO_INITS) -S runtest.vim $*.vim
@@ -498,6 +498,51 @@ func Test_empty_doau()
   doau \|
 endfunc
 
+" Patterns without wildcards are matched without the regexp, check they give
+" the same result.
+func Test_autocmd_literal_pattern()
+  let save_fic = &fileignorecase
+  set nofileignorecase
+  let g:matched = []
+  augroup testing
+    au User * call add(g:matched, 'any')
+    au User Xfile.txt call add(g:matched, 'name')
+    au User *.txt call add(g:matched, 'ext')
+    au User */Xdir/Xfile.txt call add(g:matched, 'path')
+    au User */Xdir/X* call add(g:matched, 'regexp')
+  augroup END
+
+  doautocmd User Xfile.txt
+  call assert_equal(['any', 'name', 'ext'], g:matched)
+  let g:matched = []
+  doautocmd User Xtop/Xdir/Xfile.txt
+  call assert_equal(['any', 'name', 'ext', 'path', 'regexp'], g:matched)
+  if has('win32')
+    " A '/' in the pattern also matches a backslash.
+    let g:matched = []
+    doautocmd User Xtop\Xdir\Xfile.txt
+    call assert_equal(['any', 'name', 'ext', 'path', 'regexp'], g:matched)
+  endif
+  let g:matched = []
+  doautocmd User Xfile.txt.orig
+  call assert_equal(['any'], g:matched)
+  let g:matched = []
+  doautocmd User XFILE.TXT
+  call assert_equal(['any'], g:matched)
+
+  set fileignorecase
+  let g:matched = []
+  doautocmd User XFILE.TXT
+  call assert_equal(['any', 'name', 'ext'], g:matched)
+  let g:matched = []
+  doautocmd User Xtop/XDIR/Xfile.TXT
+  call assert_equal(['any', 'name', 'ext', 'path', 'regexp'], g:matched)
+  let &fileignorecase = save_fic
+
+  au! testing
+  unlet g:matched
+endfunc
+
 func s:AutoCommandOptionSet(match)
   let template = "Option: <%s>, OldVal: <%s>, OldValLocal: <%s>, OldValGlobal: <%s>, NewVal: <%s>, Scope: <%s>, Command: <%s>\n"
   let item     = remove(g:options, 0)
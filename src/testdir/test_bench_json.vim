@@ -0,0 +1,66 @@
+" Benchmarks for encoding and decoding JSON, using messages like the ones a
+" language server sends and receives.  Reports the throughput in Mbyte/sec.
+
+source check.vim
+CheckFeature reltime
+CheckFeature float
+
+" A completion result with "count" items.
+func CompletionItems(count)
+  let items = []
+  for i in range(a:count)
+    call add(items, #{
+          \ label: 'function_name_' .. i,
+          \ kind: i % 25 + 1,
+          \ detail: 'func(arg: string, count: number): list<string>',
+          \ documentation: #{
+          \   kind: 'markdown',
+          \   value: "Returns the items.\n\n```vim\nlet x = Func(\"a\", 3)\n```\n"},
+          \ sortText: printf('%08d', i),
+          \ insertText: 'function_name_' .. i .. '(${1:arg}, ${2:count})',
+          \ insertTextFormat: 2,
+          \ })
+  endfor
+  return #{jsonrpc: '2.0', id: 12, result: #{isIncomplete: v:false, items: items}}
+endfunc
+
+" A didChange notification with the text of a buffer of "count" lines.
+func DidChange(count)
+  let lines = []
+  for i in range(a:count)
+    call add(lines, "\tlet var_" .. i .. ' = "value ' .. i .. '"  " comment')
+  endfor
+  return #{jsonrpc: '2.0', method: 'textDocument/didChange', params: #{
+        \ textDocument: #{uri: 'file:///home/user/src/file.vim', version: 7},
+        \ contentChanges: [#{text: join(lines, "\n")}]}}
+endfunc
+
+func Measure(name, msg, count)
+  let encoded = json_encode(a:msg)
+  let mbytes = len(encoded) * a:count / 1048576.0
+  for n in range(3)
+    let start = reltime()
+    for i in range(a:count)
+      let s = json_encode(a:msg)
+    endfor
+    let secs = reltimefloat(reltime(start))
+    call writefile([printf('json_encode %s: %.1f Mbyte/sec', a:name,
+          \ mbytes / secs)], 'benchmark.out', 'a')
+
+    let start = reltime()
+    for i in range(a:count)
+      let d = json_decode(encoded)
+    endfor
+    let secs = reltimefloat(reltime(start))
+    call writefile([printf('json_decode %s: %.1f Mbyte/sec', a:name,
+          \ mbytes / secs)], 'benchmark.out', 'a')
+  endfor
+  call assert_equal(a:msg, json_decode(encoded))
+endfunc
+
+func Test_Json_Benchmark()
+  call Measure('completion', CompletionItems(2000), 20)
+  call Measure('didChange', DidChange(20000), 20)
+endfunc
+
+" vim: shiftwidth=2 sts=2 expandtab
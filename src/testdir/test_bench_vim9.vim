@@ -0,0 +1,89 @@
+" Benchmarks for executing compiled :def functions.
+" Compare the times of a build with and without +vim9_threaded, e.g. by
+" adding -DNO_VIM9_THREADED to CFLAGS.
+
+source check.vim
+CheckFeature reltime
+
+def BenchArithmetic(count: number): number
+  let total = 0
+  let i = 0
+  while i < count
+    total += i % 7 * 3 - 1
+    i += 1
+  endwhile
+  return total
+enddef
+
+def BenchConcat(count: number): number
+  let total = 0
+  let i = 0
+  while i < count
+    let s = 'x'
+    s ..= 'abc'
+    s ..= 'def'
+    total += len(s)
+    i += 1
+  endwhile
+  return total
+enddef
+
+def BenchList(count: number): number
+  let l = range(100)
+  let total = 0
+  let i = 0
+  while i < count
+    total += l[i % 100]
+    i += 1
+  endwhile
+  return total
+enddef
+
+def BenchDict(count: number): number
+  let d = #{one: 1, two: 2, three: 3}
+  let total = 0
+  let i = 0
+  while i < count
+    total += d.one + d.two + d.three
+    i += 1
+  endwhile
+  return total
+enddef
+
+def Add(a: number, b: number): number
+  return a + b
+enddef
+
+def BenchCall(count: number): number
+  let total = 0
+  let i = 0
+  while i < count
+    total = Add(total, i)
+    i += 1
+  endwhile
+  return total
+enddef
+
+func Measure(name, Func, count, expected)
+  for n in range(3)
+    let start = reltime()
+    let res = a:Func(a:count)
+    let s = 'vim9 ' .. a:name .. ', threaded: ' .. has('vim9_threaded') ..
+          \ ', time: ' .. reltimestr(reltime(start))
+    call writefile([s], 'benchmark.out', 'a')
+    call assert_equal(a:expected, res)
+  endfor
+endfunc
+
+func Test_Vim9_Benchmark()
+  " compile before measuring
+  defcompile
+
+  call Measure('arithmetic', function('BenchArithmetic'), 1000000, 7999991)
+  call Measure('concat', function('BenchConcat'), 200000, 1400000)
+  call Measure('list', function('BenchList'), 1000000, 49500000)
+  call Measure('dict', function('BenchDict'), 500000, 3000000)
+  call Measure('call', function('BenchCall'), 300000, 44999850000)
+endfunc
+
+" vim: shiftwidth=2 sts=2 expandtab
@@ -179,6 +179,30 @@ func Test_deletebufline()
   exe "bwipe! " . b
 endfunc
 
+" Deleting a range that spans several memline data blocks
+func Test_deletebufline_many_lines()
+  new
+  let lines = map(range(1, 5000), {i, v -> repeat('x', v % 37) .. v})
+  call setline(1, lines)
+  let &undolevels = &undolevels
+  call assert_equal(0, deletebufline('', 100, 4000))
+  call assert_equal(lines[:98] + lines[4000:], getline(1, '$'))
+  call assert_equal(1 + len(join(lines[:98], "\n")) + 1, line2byte(100))
+  undo
+  call assert_equal(lines, getline(1, '$'))
+  call assert_equal(1 + len(join(lines[:2998], "\n")) + 1, line2byte(3000))
+  let &undolevels = &undolevels
+
+  2,$-1d _
+  call assert_equal([lines[0], lines[-1]], getline(1, '$'))
+  call assert_equal(len(lines[0]) + 2, line2byte(2))
+  undo
+  call assert_equal(lines, getline(1, '$'))
+  %d _
+  call assert_equal([''], getline(1, '$'))
+  bwipe!
+endfunc
+
 func Test_appendbufline_redraw()
   CheckScreendump
 
@@ -94,6 +94,11 @@ func Ch_communicate(port)
   call WaitFor('exists("g:split")')
   call assert_equal(123, g:split)
 
+  " split in a string with a bracket and an escaped quote should work
+  call assert_equal('ok', ch_evalexpr(handle, 'split string'))
+  call WaitFor('exists("g:split_str")')
+  call assert_equal('a]{"b', g:split_str)
+
   " string with ][ should work
   call assert_equal('this][that', ch_evalexpr(handle, 'echo this][that'))
 
@@ -1320,6 +1325,41 @@ func Test_out_cb_lambda()
   endtry
 endfunc
 
+" Output of several jobs at the same time invokes the callback of each of them,
+" also after some of the jobs ended.
+func Test_out_cb_many_jobs()
+  let g:Ch_outlist = []
+  let jobs = []
+  for i in range(8)
+    call add(jobs, job_start(s:python .. ' test_channel_pipe.py',
+          \ {'out_cb': {ch, msg -> add(g:Ch_outlist, msg)}}))
+  endfor
+  try
+    for i in range(8)
+      call ch_sendraw(jobs[i], 'echo job' .. i .. "\n")
+    endfor
+    call WaitForAssert({-> assert_equal(8, len(g:Ch_outlist))})
+    call assert_equal(map(range(8), '"job" .. v:val'), sort(g:Ch_outlist))
+
+    for i in range(0, 7, 2)
+      call job_stop(jobs[i])
+      call WaitForAssert({-> assert_equal('dead', job_status(jobs[i]))})
+    endfor
+    let g:Ch_outlist = []
+    for i in range(1, 7, 2)
+      call ch_sendraw(jobs[i], 'echo again' .. i .. "\n")
+    endfor
+    call WaitForAssert({-> assert_equal(4, len(g:Ch_outlist))})
+    call assert_equal(map(range(1, 7, 2), '"again" .. v:val'),
+          \ sort(g:Ch_outlist))
+  finally
+    for job in jobs
+      call job_stop(job)
+    endfor
+    unlet g:Ch_outlist
+  endtry
+endfunc
+
 func Test_close_and_exit_cb()
   let g:retdict = {'ret': {}}
   func g:retdict.close_cb(ch) dict
@@ -197,3 +197,62 @@ func Test_edit_long_file_name()
   call delete(longName)
 endfunc
 
+
+" Clearing to the end of a line is postponed until it is known what is drawn
+" there, check the terminal shows the right text after messages, cursor
+" moves, attribute changes and scrolling.
+func Test_postponed_clear()
+  CheckScreendump
+
+  let lines =<< trim END
+      call setline(1, ['short', 'a much longer line with text', 'xx',
+            \ 'the last longer line of the text'] + range(1, 20))
+      call matchadd('Search', 'longer')
+      set ruler laststatus=1
+  END
+  call writefile(lines, 'XtestPostponedClear')
+  let buf = RunVimInTerminal('-S XtestPostponedClear', #{rows: 8, cols: 50})
+
+  " a shorter message replaces a longer one
+  call term_sendkeys(buf, ":echo 'a long message that fills the line'\<CR>")
+  call term_sendkeys(buf, ":echo 'short'\<CR>")
+  " the ruler gets shorter when the cursor moves
+  call term_sendkeys(buf, "j$k0")
+  call VerifyScreenDump(buf, 'Test_postponed_clear_1', {})
+
+  " the same text with another attribute
+  call term_sendkeys(buf, ":echohl ErrorMsg | echo 'some text' | echohl None\<CR>")
+  call VerifyScreenDump(buf, 'Test_postponed_clear_2', {})
+  call term_sendkeys(buf, ":echo 'some text'\<CR>")
+  call VerifyScreenDump(buf, 'Test_postponed_clear_3', {})
+
+  " messages scroll the screen up
+  call term_sendkeys(buf, ":echo \"one\\ntwo\\nthree is longer\"\<CR>")
+  call VerifyScreenDump(buf, 'Test_postponed_clear_4', {})
+  call term_sendkeys(buf, "\<CR>")
+  call VerifyScreenDump(buf, 'Test_postponed_clear_5', {})
+
+  " scrolling the window with a message displayed
+  call term_sendkeys(buf, ":echo 'a message'\<CR>")
+  call term_sendkeys(buf, "3\<C-E>")
+  call VerifyScreenDump(buf, 'Test_postponed_clear_6', {})
+
+  call StopVimInTerminal(buf)
+  call delete('XtestPostponedClear')
+endfunc
+
+" Redrawing the whole screen is written to the terminal at once.
+func Test_redraw_single_write()
+  CheckNotGui
+
+  new
+  only
+  call setline(1, repeat(['xy'->repeat(&columns / 2 - 1)], &lines))
+  call matchadd('Search', 'x')
+  redraw!
+  call assert_equal(1, test_getvalue('term_frame_writes'))
+  call assert_true(test_getvalue('term_frame_bytes') > 2047)
+
+  call clearmatches()
+  bwipe!
+endfunc
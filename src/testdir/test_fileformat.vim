@@ -298,4 +298,26 @@ func Test_fileformat_plusplus_read()
   call assert_fails('e ++abc1 Xfile1', 'E474:')
 endfunc
 
+" Line ends, NULs and multibyte characters at every position within a word
+func Test_fileformat_read_line_ends()
+  let lines = []
+  for i in range(40)
+    call add(lines, repeat('a', i) .. "\n" .. repeat('b', i % 9))
+    call add(lines, repeat('c', i) .. 'é' .. repeat('d', i % 11))
+  endfor
+  call writefile(lines, 'Xfile1')
+  new
+  e! ++ff=unix ++enc=utf-8 Xfile1
+  call assert_equal(lines, getline(1, '$'))
+  call assert_equal('utf-8', &fileencoding)
+  bwipe!
+
+  call writefile(map(copy(lines), 'v:val .. "\r"'), 'Xfile1')
+  new
+  e! ++ff=dos Xfile1
+  call assert_equal(lines, getline(1, '$'))
+  bwipe!
+  call delete('Xfile1')
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
@@ -1059,6 +1059,37 @@ func Test_byte2line_line2byte()
   bw!
 endfunc
 
+" line2byte() and byte2line() on a buffer with many chunks of lines
+func Test_byte2line_line2byte_many_lines()
+  new
+  let lines = map(range(1, 20000), {i, v -> repeat('x', v % 23) .. v})
+  call setline(1, lines)
+  let offsets = [1]
+  for l in lines
+    call add(offsets, offsets[-1] + len(l) + 1)
+  endfor
+  for lnum in [1, 2, 799, 800, 801, 5000, 12345, 19999, 20000, 20001]
+    call assert_equal(offsets[lnum - 1], line2byte(lnum))
+    call assert_equal(lnum > 20000 ? -1 : lnum, byte2line(offsets[lnum - 1]))
+    if lnum > 1 && lnum <= 20000
+      call assert_equal(lnum - 1, byte2line(offsets[lnum - 1] - 1))
+    endif
+  endfor
+
+  " delete and insert lines, offsets after that are updated
+  3000,9000d _
+  call append(100, repeat(['abc'], 2000))
+  call assert_equal(offsets[100] + 2000 * 4, line2byte(2101))
+  call assert_equal(offsets[2999] + 2000 * 4, line2byte(5000))
+  call assert_equal(5000, byte2line(line2byte(5000)))
+
+  set fileformat=dos
+  call assert_equal(offsets[100] + 2000 * 4 + 2100, line2byte(2101))
+  call assert_equal(2101, byte2line(offsets[100] + 2000 * 4 + 2100))
+  set fileformat&
+  bwipe!
+endfunc
+
 " Test for byteidx() and byteidxcomp() functions
 func Test_byteidx()
   let a = '.é.' " one char of two bytes
@@ -300,3 +300,17 @@ func Test_json_encode_long()
   let json = json_encode([repeat('a', 3996)])
   call assert_equal(4000, len(json))
 endfunc
+
+func Test_json_encode_long_string()
+  " Characters that need escaping at any position in a long string.
+  let plain = repeat('abcdefghijklmnop', 3)
+  for i in range(len(plain))
+    for [c, e] in [['"', '\"'], ["\\", '\\'], ["\n", '\n'], ["\x01", '\u0001'],
+          \ ['¢', '¢'], ["\x7f", "\x7f"]]
+      let s = strpart(plain, 0, i) .. c .. strpart(plain, i)
+      let json = '"' .. strpart(plain, 0, i) .. e .. strpart(plain, i) .. '"'
+      call assert_equal(json, json_encode(s))
+      call assert_equal(s, json_decode(json))
+    endfor
+  endfor
+endfunc
@@ -931,6 +931,33 @@ func Test_listdict_index()
   call assert_fails("echo t[0]", 'E685:')
 endfunc
 
+" Test indexing a long list in random order while changing it
+func Test_list_index_long()
+  let l = range(100)
+  call assert_equal([50, 90, 10, 70, 30], [l[50], l[90], l[10], l[70], l[30]])
+  call add(l, 100)
+  call assert_equal([100, 5, 95], [l[100], l[5], l[-6]])
+  call insert(l, -1, 50)
+  call assert_equal([49, -1, 50, 99], [l[49], l[50], l[51], l[100]])
+  call remove(l, 10, 19)
+  call assert_equal([9, 20, 89, 100], [l[9], l[10], l[80], l[-1]])
+  call remove(l, -1)
+  call assert_equal([99, 0, 79], [l[-1], l[0], l[70]])
+  call reverse(l)
+  call assert_equal([99, 0, 20, 50, -1], [l[0], l[-1], l[-11], l[49], l[50]])
+  call sort(l, 'n')
+  call assert_equal([-1, 0, 9, 20, 99], [l[0], l[1], l[10], l[11], l[-1]])
+  let l += [99, 99, 98]
+  call uniq(l)
+  call assert_equal([99, 98], l[-2:])
+  call assert_equal([0, 9, 20], [l[1], l[10], l[11]])
+  call assert_equal(92, len(l))
+  call assert_equal(range(60, 69), l[51:60])
+  call filter(l, 'v:val % 2 == 0')
+  call assert_equal([98, 98, 0], [l[-1], l[-2], l[0]])
+  call assert_equal([22, 62, 98], [l[6], l[26], l[44]])
+endfunc
+
 " Test for a null list
 func Test_null_list()
   let l = test_null_list()
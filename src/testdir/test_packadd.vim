@@ -1,5 +1,6 @@
 " Tests for 'packpath' and :packadd
 
+source check.vim
 
 func SetUp()
   let s:topdir = getcwd() . '/Xdir'
@@ -249,6 +250,32 @@ func Test_packloadall()
   call assert_equal(4321, g:plugin_bar_number)
 endfunc
 
+" The "start" packages are added to 'runtimepath' in one go, the result must
+" be the same as when adding them one by one.
+func Test_packloadall_rtp_order()
+  for name in ['one', 'two', 'three']
+    call mkdir(&packpath . '/pack/mine/start/' . name . '/plugin', 'p')
+  endfor
+  call mkdir(&packpath . '/pack/mine/start/two/after', 'p')
+  let dir = &packpath . '/pack/mine/start/'
+
+  exe 'set rtp=' . &packpath . ',/xx,/xx/after'
+  packloadall!
+  call assert_equal(&packpath . ',' . dir . 'two,' . dir . 'three,'
+        \ . dir . 'one,/xx,' . dir . 'two/after,/xx/after', &rtp)
+  let rtp = &rtp
+  packloadall!
+  call assert_equal(rtp, &rtp)
+
+  " Not found and no "after" directory: appended.
+  set rtp=/xx,
+  packloadall!
+  call assert_equal('/xx,,' . dir . 'one,' . dir . 'two,' . dir . 'three,'
+        \ . dir . 'two/after', &rtp)
+
+  set rtp&
+endfunc
+
 func Test_helptags()
   let docdir1 = &packpath . '/pack/mine/start/foo/doc'
   let docdir2 = &packpath . '/pack/mine/start/bar/doc'
@@ -358,4 +385,35 @@ func Test_runtime()
   call assert_equal('runstartopt', g:sequence)
 endfunc
 
+" A directory that was indexed must be read again when it changes.
+func Test_runtime_new_dir()
+  CheckUnix
+  let rundir = &packpath . '/runtime'
+  call mkdir(rundir . '/extra', 'p')
+  call writefile(['let g:sequence .= "extra"'], rundir . '/extra/bar.vim')
+  exe 'set rtp=' . rundir
+  " make the directory old enough to be indexed
+  call system('touch -d "1 hour ago" ' . rundir)
+
+  let g:sequence = ''
+  runtime extra/bar.vim newdir/bar.vim
+  call assert_equal('extra', g:sequence)
+
+  " a backslash in the first name is not looked up in the index
+  let g:sequence = ''
+  runtime ex\tra/bar.vim
+  call assert_equal('extra', g:sequence)
+
+  call mkdir(rundir . '/newdir')
+  call writefile(['let g:sequence .= "newdir"'], rundir . '/newdir/bar.vim')
+  let g:sequence = ''
+  runtime! newdir/bar.vim
+  call assert_equal('newdir', g:sequence)
+
+  call delete(rundir . '/newdir', 'rf')
+  let g:sequence = ''
+  runtime! newdir/bar.vim
+  call assert_equal('', g:sequence)
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
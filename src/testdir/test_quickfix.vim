@@ -2773,6 +2773,56 @@ func Test_vimgrep_incsearch()
   set noincsearch
 endfunc
 
+" Test vimgrep skipping files that cannot contain a match
+func Test_vimgrep_skip_files()
+  call writefile(['one', 'two fooBar', 'three'], 'Xvgr1.txt')
+  call writefile(['nothing here'], 'Xvgr2.txt')
+  call writefile(['FOOBAR', 'Foo', 'bar'], 'Xvgr3.txt')
+  call writefile(['abc', repeat('x', 70000) .. 'foobar'], 'Xvgr4.txt')
+
+  silent! %bwipe!
+  vimgrep /foo\(Bar\|baz\)/ Xvgr*.txt
+  call assert_equal([['Xvgr1.txt', 2]],
+        \ map(getqflist(), {_, v -> [bufname(v.bufnr), v.lnum]}))
+
+  call assert_fails('vimgrep /foobar\C/ Xvgr1.txt Xvgr2.txt Xvgr3.txt', 'E480:')
+
+  vimgrep /\cfoobar/ Xvgr*.txt
+  call assert_equal([['Xvgr1.txt', 2], ['Xvgr3.txt', 1], ['Xvgr4.txt', 2]],
+        \ map(getqflist(), {_, v -> [bufname(v.bufnr), v.lnum]}))
+  set ignorecase
+  vimgrep /foo\nbar/ Xvgr*.txt
+  call assert_equal([['Xvgr3.txt', 2]],
+        \ map(getqflist(), {_, v -> [bufname(v.bufnr), v.lnum]}))
+  set ignorecase&
+
+  " "i" matches "\u0130" when ignoring case
+  call writefile(["a\u0130z"], 'Xvgr5.txt')
+  vimgrep /\%#=2\caiz/ Xvgr5.txt
+  call assert_equal([['Xvgr5.txt', 1]],
+        \ map(getqflist(), {_, v -> [bufname(v.bufnr), v.lnum]}))
+
+  " an autocommand may change the text read from the file
+  augroup QF_Test
+    au!
+    au BufReadPost Xvgr2.txt call setline(1, 'foobar')
+  augroup END
+  vimgrep /foobar/ Xvgr2.txt
+  call assert_equal([['Xvgr2.txt', 1]],
+        \ map(getqflist(), {_, v -> [bufname(v.bufnr), v.lnum]}))
+  augroup QF_Test
+    au!
+  augroup END
+
+  call delete('Xvgr1.txt')
+  call delete('Xvgr2.txt')
+  call delete('Xvgr3.txt')
+  call delete('Xvgr4.txt')
+  call delete('Xvgr5.txt')
+  silent! %bwipe!
+  call setqflist([], 'f')
+endfunc
+
 " Test vimgrep with the last search pattern not set
 func Test_vimgrep_with_no_last_search_pat()
   let lines =<< trim [SCRIPT]
@@ -95,7 +95,8 @@ endfunc
 
 func Test_out_of_memory()
   new
-  s/^/,n
+  " Include the ";", lines without it are skipped before trying to match.
+  s/^/,n;
   " This will be slow...
   call assert_fails('call search("\\v((n||<)+);")', 'E363:')
 endfunc
@@ -930,4 +931,109 @@ func Test_regexp_last_subst_string()
   close!
 endfunc
 
+" Test for patterns with text that every match must contain
+func Test_regexp_required_text()
+  let tl = [
+        \ ['\w\+foo\d', 'xx foo1 barfoo2', 'barfoo2'],
+        \ ['\w\+foo\d', 'xx foo1 barfoo', ''],
+        \ ['\(ab\)\+cd\(ef\)*', 'abab abcd', 'abcd'],
+        \ ['x\(ab\|cd\)*y', 'xaby xy', 'xaby'],
+        \ ['a\%[bc]d', 'acd abd', 'abd'],
+        \ ['\<\k\+\>!', 'foo bar!', 'bar!'],
+        \ ['[abc]\+xyz', 'aaxy bbxyz', 'bbxyz'],
+        \ ['\d\+\cFoO', '12foo', '12foo'],
+        \ ['\d\+\CFoO', '12foo', ''],
+        \ ['\(foo\)\@<=bar\d', 'foobar1', 'bar1'],
+        \ ['foo\zsbar\d*', 'foobar12 bar', 'bar12'],
+        \ ['\(ab\)\@!\w\+cd', 'abcd xbcd', 'bcd'],
+        \ ]
+  for engine in [1, 2]
+    for t in tl
+      call assert_equal(t[2], matchstr(t[1], '\%#=' .. engine .. t[0]),
+            \ engine .. ': ' .. t[0])
+    endfor
+  endfor
+
+  " the required text may be in a following line
+  new
+  call setline(1, ['one two', 'three', 'four five'])
+  for engine in [1, 2]
+    call cursor(1, 1)
+    call assert_equal([1, 7], searchpos('\%#=' .. engine .. 'o\w*\nthree'))
+    call cursor(1, 1)
+    call assert_equal([1, 5],
+          \ searchpos('\%#=' .. engine .. 't\_.\{-}four\s\+five'))
+  endfor
+  set ignorecase
+  call assert_equal(3, search('\%#=2\a\+ FIVE'))
+  set ignorecase&
+  bwipe!
+endfunc
+
+" Check that states kept when matching many lines with the NFA engine don't
+" change the result.
+func Test_regexp_nfa_dfa()
+  new
+  call setline(1, repeat(['foo bar baz'], 20) + ['bar123x', 'foo 12 x', ''])
+  let tl = [
+        \ ['\(foo\|bar\)\d\+x', [21, 1]],
+        \ ['\cBAR\d\+X', [21, 1]],
+        \ ['\d x$', [22, 6]],
+        \ ['^\d', [0, 0]],
+        \ ['^$', [23, 1]],
+        \ ['\<\d\+\>\s*x', [22, 5]],
+        \ ['\(ba\)\@<=\d\+', [0, 0]],
+        \ ['\(ar\)\@<=\d\+', [21, 4]],
+        \ ['z[^ ]', [0, 0]],
+        \ ['\(ba\)\@!\w\w\d\+', [21, 2]],
+        \ ]
+  for engine in [1, 2]
+    for t in tl
+      call cursor(1, 1)
+      call assert_equal(t[1], searchpos('\%#=' .. engine .. t[0], 'c'),
+            \ engine .. ': ' .. t[0])
+    endfor
+  endfor
+
+  " The result depends on 'iskeyword', a syntax pattern is used for many
+  " lines.
+  call setline(1, repeat(['-- x'], 20) + ['a--x', 'b x'])
+  call deletebufline('', 23, '$')
+  syn match TestKeyword '\%#=2\k\+x'
+  call assert_equal(repeat([0], 21),
+        \ map(range(1, 21), {_, l -> synID(l, 1, 0)}))
+  setlocal iskeyword+=-
+  call setline(21, 'a--x')
+  call assert_equal('TestKeyword', synIDattr(synID(21, 1, 0), 'name'))
+  syn clear
+  bwipe!
+endfunc
+
+" A compiled pattern is used again by the next function using it.
+func Test_regexp_reuse_compiled()
+  call assert_equal(['a1', 'b1'], filter(['a1', 'b2', 'b1'], 'v:val =~ "1"'))
+  call assert_equal(['a', 'b', 'a'], map(['ax', 'bx', 'ax'],
+        \ 'substitute(v:val, "x", "", "")'))
+
+  " nested use of the same pattern
+  call assert_equal('azc', substitute('ab', 'b',
+        \ '\=substitute("zb", "b", "c", "")', ''))
+  call assert_equal('azc', substitute('ab', 'b',
+        \ '\=substitute("zb", "b", "c", "")', ''))
+
+  " the previous substitute string and 'iskeyword' are used when compiling
+  new
+  call setline(1, ['x', 'x'])
+  1s/x/abcd/
+  call assert_equal(1, match('xabcd', '~'))
+  2s/x/ef/
+  call assert_equal(-1, match('xabcd', '~'))
+  call assert_equal(1, match('xef', '~'))
+  setlocal iskeyword=@
+  call assert_equal('', matchstr('-', '\%#=1[[:keyword:]]'))
+  setlocal iskeyword+=-
+  call assert_equal('-', matchstr('-', '\%#=1[[:keyword:]]'))
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
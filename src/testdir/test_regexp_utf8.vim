@@ -355,4 +355,19 @@ func Test_ambiwidth()
   set regexpengine& ambiwidth&
 endfunc
 
+" The text that every match must contain is checked ignoring case like both
+" engines do.  "İ" lowers to "i" but does not fold to it.
+func Test_required_text_ignorecase()
+  call assert_equal(0, match("aİz", '\%#=2\ca\+iz'))
+  call assert_equal(0, match("xİz", '\%#=2\cx\w\?iz'))
+  call assert_equal(0, match("xxi", '\%#=2\cx\+İ'))
+
+  call writefile(['aİz'], 'Xrequired')
+  vimgrep /\%#=2\ca\+iz/ Xrequired
+  call assert_equal(1, len(getqflist()))
+  call assert_equal('aİz', getqflist()[0].text)
+  call setqflist([], 'f')
+  call delete('Xrequired')
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
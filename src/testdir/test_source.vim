@@ -93,4 +93,34 @@ func Test_source_error()
   call assert_fails('scriptversion 2', 'E984:')
 endfunc
 
+" The text of a sourced script is kept for sourcing it again, a changed script
+" must still be read again.
+func Test_source_changed_script()
+  call writefile(['let g:val = 1', 'let g:lines = "one\ntwo"'], 'Xchanged.vim')
+  if has('unix') && executable('touch')
+    " An old timestamp, so that the text can be kept.
+    silent !touch -d "1 hour ago" Xchanged.vim
+  endif
+  source Xchanged.vim
+  call assert_equal(1, g:val)
+  source Xchanged.vim
+  call assert_equal(1, g:val)
+  call assert_equal("one\ntwo", g:lines)
+
+  " Same size, different text.
+  call writefile(['let g:val = 2', 'let g:lines = "one\ntwo"'], 'Xchanged.vim')
+  source Xchanged.vim
+  call assert_equal(2, g:val)
+
+  " Lines continued with a backslash and a last line without a line break.
+  call writefile(['let g:val = [', '      \ 3]', 'let g:lines = 4'],
+        \ 'Xchanged.vim', 'b')
+  source Xchanged.vim
+  call assert_equal([3], g:val)
+  call assert_equal(4, g:lines)
+
+  call delete('Xchanged.vim')
+  unlet g:val g:lines
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
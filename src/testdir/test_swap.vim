@@ -377,4 +377,30 @@ func Test_swap_prompt_splitwin()
   call delete('Xfile1')
 endfunc
 
+" Blocks read by scanning the buffer should not push out the other blocks,
+" otherwise every scan of a buffer larger than 'maxmem' reads all blocks.
+func Test_swap_scan_keeps_blocks()
+  let save_mm = &maxmem
+  let save_mmt = &maxmemtot
+  set maxmem=1024 maxmemtot=1024
+  new
+  call setline(1, map(range(30000), '"line " .. v:val .. repeat(" x", 20)'))
+  call search('nomatch', 'w')
+  let misses = test_getvalue('memfile_misses')
+  let hits = test_getvalue('memfile_hits')
+  call assert_true(misses > 0)
+
+  " Each data block is found through a pointer block that stays in memory.
+  " If the scan pushed out all data blocks, there would be about as many
+  " misses as hits.
+  call search('nomatch', 'w')
+  let misses = test_getvalue('memfile_misses') - misses
+  let hits = test_getvalue('memfile_hits') - hits
+  call assert_true(misses * 2 < hits, misses .. ' misses, ' .. hits .. ' hits')
+
+  bwipe!
+  let &maxmem = save_mm
+  let &maxmemtot = save_mmt
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
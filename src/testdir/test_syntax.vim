@@ -641,6 +641,31 @@ func Test_syntax_c()
   call delete('Xtest.c')
 endfun
 
+" Lines below the window are parsed while waiting for a character, the states
+" stored then must be updated for a change above them.
+func Test_syntax_idle_parse()
+  CheckRunVimInTerminal
+  let lines =<< trim END
+    syn region MyComment start=+/\*+ end=+\*/+
+    syn sync fromstart
+    call setline(1, repeat(['x = 1;'], 3000) + ['end */', 'y = 2;'])
+  END
+  call writefile(lines, 'Xtest_idle.vim')
+  let buf = RunVimInTerminal('-S Xtest_idle.vim', {})
+  call TermWait(buf, 500)
+
+  call term_sendkeys(buf, "ggO/*\<Esc>")
+  call TermWait(buf, 500)
+  call term_sendkeys(buf, ":call writefile([synIDattr(synID(3001, 1, 0), "
+        \ .. "'name'), synIDattr(synID(3003, 1, 0), 'name')], 'Xidle_result')\r")
+  call WaitForAssert({-> assert_equal(['MyComment', ''],
+        \ filereadable('Xidle_result') ? readfile('Xidle_result') : [])})
+
+  call StopVimInTerminal(buf)
+  call delete('Xtest_idle.vim')
+  call delete('Xidle_result')
+endfunc
+
 " Using \z() in a region with NFA failing should not crash.
 func Test_syn_wrong_z_one()
   new
@@ -691,4 +716,53 @@ func Test_syntax_after_bufdo()
   call delete('Xddd.c')
 endfunc
 
+" Return the total number of pattern tries when redrawing the window above.
+func s:RedrawOtherCount()
+  syntime clear
+  syntime on
+  wincmd k
+  redraw!
+  wincmd j
+  syntime off
+  return split(execute('syntime report'), '\n')[-1]->split()[1]
+endfunc
+
+" The syntax states of lines displayed in a window are kept when another
+" window on the same buffer scrolls through the buffer.
+func Test_syntax_keep_displayed_states()
+  CheckFeature profile
+  new
+  call setline(1, ['/* comment'] + map(range(2, 10000), '"x " .. v:val'))
+  syn region XComment start=+/\*+ end=+\*/+
+  syn match XNumber /\d\+/ contained containedin=XComment
+  syn sync fromstart
+  split
+  resize 10
+  normal! 5000Gzt
+  wincmd j
+  normal! 9981Gzt
+  redraw!
+  let before = s:RedrawOtherCount()
+
+  for lnum in range(1, 9981, 10) + [9981]
+    exe 'normal! ' .. lnum .. 'Gzt'
+    redraw
+  endfor
+  call assert_equal(before, s:RedrawOtherCount())
+
+  wincmd k
+  call assert_equal(5000, line('w0'))
+  call assert_equal(['XComment', 'XNumber'],
+        \ map(synstack(5000, 3), 'synIDattr(v:val, "name")'))
+  exe "normal! 3\<C-E>"
+  redraw
+  call assert_equal(5003, line('w0'))
+  call assert_equal(['XComment', 'XNumber'],
+        \ map(synstack(5010, 3), 'synIDattr(v:val, "name")'))
+
+  syntax clear
+  only
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
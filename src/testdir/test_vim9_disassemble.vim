@@ -42,7 +42,7 @@ def Test_disassemble_load()
         'buffers.*' ..
         ' EXEC \+buffers.*' ..
         ' LOAD arg\[-1\].*' ..
-        ' LOAD $0.*' ..
+        ' LOADSCALAR $0.*' ..
         ' LOADOPT &lines.*' ..
         ' LOADV v:version.*' ..
         ' LOADS s:scriptvar from .*test_vim9_disassemble.vim.*' ..
@@ -72,7 +72,7 @@ def Test_disassemble_exec_expr()
         ' edit the`=filename``=filenr`.txt.*' ..
         '\d PUSHS "edit the".*' ..
         '\d LOAD $0.*' ..
-        '\d LOAD $1.*' ..
+        '\d LOADSCALAR $1.*' ..
         '\d 2STRING stack\[-1\].*' ..
         '\d PUSHS ".txt".*' ..
         '\d EXECCONCAT 4.*' ..
@@ -228,8 +228,7 @@ def Test_disassemble_try()
         'catch /fail/\_s*' ..
         '\d JUMP -> \d\+\_s*' ..
         '\d PUSH v:exception\_s*' ..
-        '\d PUSHS "fail"\_s*' ..
-        '\d COMPARESTRING =\~\_s*' ..
+        '\d COMPARESTRINGCONST =\~ "fail"\_s*' ..
         '\d JUMP_IF_FALSE -> \d\+\_s*' ..
         '\d CATCH\_s*' ..
         'echo "no"\_s*' ..
@@ -238,9 +237,7 @@ def Test_disassemble_try()
         'finally\_s*' ..
         'throw "end"\_s*' ..
         '\d\+ PUSHS "end"\_s*' ..
-        '\d\+ THROW\_s*' ..
-        'endtry\_s*' ..
-        '\d\+ ENDTRY',
+        '\d\+ THROW$',
         res)
 enddef
 
@@ -655,10 +652,10 @@ def Test_disassemble_for_loop()
         '\d PUSHNR 3\_s*' ..
         '\d BCALL range(argc 1)\_s*' ..
         '\d FOR $1 -> \d\+\_s*' ..
-        '\d STORE $2\_s*' ..
+        '\d STORESCALAR $2\_s*' ..
         'res->add(i)\_s*' ..
         '\d LOAD $0\_s*' ..
-        '\d LOAD $2\_s*' ..
+        '\d LOADSCALAR $2\_s*' ..
         '\d\+ BCALL add(argc 2)\_s*' ..
         '\d\+ DROP\_s*' ..
         'endfor\_s*' ..
@@ -698,18 +695,17 @@ def Test_disassemble_computing()
         'let nr = 3.*' ..
         '\d STORE 3 in $0.*' ..
         'let nrres = nr + 7.*' ..
-        '\d LOAD $0.*' ..
-        '\d PUSHNR 7.*' ..
-        '\d OPNR +.*' ..
-        '\d STORE $1.*' ..
+        '\d LOADSCALAR $0.*' ..
+        '\d OPNRCONST + 7.*' ..
+        '\d STORESCALAR $1.*' ..
         'nrres = nr - 7.*' ..
-        '\d OPNR -.*' ..
+        '\d OPNRCONST - 7.*' ..
         'nrres = nr \* 7.*' ..
-        '\d OPNR \*.*' ..
+        '\d OPNRCONST \* 7.*' ..
         'nrres = nr / 7.*' ..
-        '\d OPNR /.*' ..
+        '\d OPNRCONST / 7.*' ..
         'nrres = nr % 7.*' ..
-        '\d OPNR %.*' ..
+        '\d OPNRCONST % 7.*' ..
         'let anyres = g:number + 7.*' ..
         '\d LOADG g:number.*' ..
         '\d PUSHNR 7.*' ..
@@ -728,12 +724,12 @@ def Test_disassemble_computing()
     assert_match('Computing.*' ..
         'let fl = 3.0.*' ..
         '\d PUSHF 3.0.*' ..
-        '\d STORE $3.*' ..
+        '\d STORESCALAR $3.*' ..
         'let flres = fl + 7.0.*' ..
-        '\d LOAD $3.*' ..
+        '\d LOADSCALAR $3.*' ..
         '\d PUSHF 7.0.*' ..
         '\d OPFLOAT +.*' ..
-        '\d STORE $4.*' ..
+        '\d STORESCALAR $4.*' ..
         'flres = fl - 7.0.*' ..
         '\d OPFLOAT -.*' ..
         'flres = fl \* 7.0.*' ..
@@ -807,7 +803,7 @@ def Test_disassemble_list_index()
         '\d LOAD $0\_s*' ..
         '\d PUSHNR 1\_s*' ..
         '\d INDEX\_s*' ..
-        '\d STORE $1\_s*',
+        '\d STORESCALAR $1\_s*',
         instr)
   assert_equal(2, ListIndex())
 enddef
@@ -828,14 +824,13 @@ def Test_disassemble_dict_member()
         '\d NEWDICT size 1\_s*' ..
         '\d STORE $0\_s*' ..
         'let res = d.item\_s*' ..
-        '\d\+ LOAD $0\_s*' ..
-        '\d\+ MEMBER item\_s*' ..
-        '\d\+ STORE $1\_s*' ..
+        '\d\+ LOADMEMBER $0.item\_s*' ..
+        '\d\+ STORESCALAR $1\_s*' ..
         'res = d\["item"\]\_s*' ..
         '\d\+ LOAD $0\_s*' ..
         '\d\+ PUSHS "item"\_s*' ..
         '\d\+ MEMBER\_s*' ..
-        '\d\+ STORE $1\_s*',
+        '\d\+ STORESCALAR $1\_s*',
         instr)
   call assert_equal(1, DictMember())
 enddef
@@ -853,13 +848,13 @@ def Test_disassemble_negate_number()
         'let nr = 9\_s*' ..
         '\d STORE 9 in $0\_s*' ..
         'let plus = +nr\_s*' ..
-        '\d LOAD $0\_s*' ..
+        '\d LOADSCALAR $0\_s*' ..
         '\d CHECKNR\_s*' ..
-        '\d STORE $1\_s*' ..
+        '\d STORESCALAR $1\_s*' ..
         'let res = -nr\_s*' ..
-        '\d LOAD $0\_s*' ..
+        '\d LOADSCALAR $0\_s*' ..
         '\d NEGATENR\_s*' ..
-        '\d STORE $2\_s*',
+        '\d STORESCALAR $2\_s*',
         instr)
   call assert_equal(-9, NegateNumber())
 enddef
@@ -876,15 +871,15 @@ def Test_disassemble_invert_bool()
   assert_match('InvertBool\_s*' ..
         'let flag = true\_s*' ..
         '\d PUSH v:true\_s*' ..
-        '\d STORE $0\_s*' ..
+        '\d STORESCALAR $0\_s*' ..
         'let invert = !flag\_s*' ..
-        '\d LOAD $0\_s*' ..
+        '\d LOADSCALAR $0\_s*' ..
         '\d INVERT (!val)\_s*' ..
-        '\d STORE $1\_s*' ..
+        '\d STORESCALAR $1\_s*' ..
         'let res = !!flag\_s*' ..
-        '\d LOAD $0\_s*' ..
+        '\d LOADSCALAR $0\_s*' ..
         '\d 2BOOL (!!val)\_s*' ..
-        '\d STORE $2\_s*',
+        '\d STORESCALAR $2\_s*',
         instr)
   call assert_equal(true, InvertBool())
 enddef
@@ -896,14 +891,14 @@ def Test_disassemble_compare()
         ['v:none == isNull', 'COMPARESPECIAL =='],
         ['v:none != isNull', 'COMPARESPECIAL !='],
 
-        ['111 == aNumber', 'COMPARENR =='],
-        ['111 != aNumber', 'COMPARENR !='],
-        ['111 > aNumber', 'COMPARENR >'],
-        ['111 < aNumber', 'COMPARENR <'],
-        ['111 >= aNumber', 'COMPARENR >='],
-        ['111 <= aNumber', 'COMPARENR <='],
-        ['111 =~ aNumber', 'COMPARENR =\~'],
-        ['111 !~ aNumber', 'COMPARENR !\~'],
+        ['111 == aNumber', 'COMPARENRJUMP == -> \d\+'],
+        ['111 != aNumber', 'COMPARENRJUMP != -> \d\+'],
+        ['111 > aNumber', 'COMPARENRJUMP > -> \d\+'],
+        ['111 < aNumber', 'COMPARENRJUMP < -> \d\+'],
+        ['111 >= aNumber', 'COMPARENRJUMP >= -> \d\+'],
+        ['111 <= aNumber', 'COMPARENRJUMP <= -> \d\+'],
+        ['111 =~ aNumber', 'COMPARENRJUMP =\~ -> \d\+'],
+        ['111 !~ aNumber', 'COMPARENRJUMP !\~ -> \d\+'],
 
         ['"xx" != aString', 'COMPARESTRING !='],
         ['"xx" > aString', 'COMPARESTRING >'],
@@ -979,12 +974,14 @@ def Test_disassemble_compare()
              'enddef'], 'Xdisassemble')
     source Xdisassemble
     let instr = execute('disassemble TestCase' .. nr)
+    " a number compare is combined with the jump
+    let jump = case[1] =~ 'JUMP' ? '' : '\d JUMP_IF_FALSE -> \d\+.*'
     assert_match('TestCase' .. nr .. '.*' ..
         'if ' .. substitute(case[0], '[[~]', '\\\0', 'g') .. '.*' ..
         '\d \(PUSH\|FUNCREF\).*' ..
         '\d \(PUSH\|FUNCREF\|LOAD\).*' ..
         '\d ' .. case[1] .. '.*' ..
-        '\d JUMP_IF_FALSE -> \d\+.*',
+        jump,
         instr)
 
     nr += 1
@@ -993,6 +990,76 @@ def Test_disassemble_compare()
   delete('Xdisassemble')
 enddef
 
+def Peephole(d: dict<number>): number
+  let i = 0
+  let total = 0
+  while i < 10
+    total += i * d.factor
+    i += 1
+  endwhile
+  if total > 100
+    return total
+  else
+    total = 0
+  endif
+  while true
+    total += 2
+    if total > 5
+      break
+    endif
+  endwhile
+  return total
+enddef
+
+def Test_disassemble_peephole()
+  let instr = execute('disassemble Peephole')
+  assert_match('Peephole\_s*' ..
+        'let i = 0\_s*' ..
+        '\d STORE 0 in $0\_s*' ..
+        'let total = 0\_s*' ..
+        '\d STORE 0 in $1\_s*' ..
+        'while i < 10\_s*' ..
+        '2 LOADSCALAR $0\_s*' ..
+        '\d COMPARENRJUMP < 10 -> 12\_s*' ..
+        'total += i \* d.factor\_s*' ..
+        '\d LOADSCALAR $1\_s*' ..
+        '\d LOADSCALAR $0\_s*' ..
+        '\d LOADMEMBER arg\[-1\].factor\_s*' ..
+        '\d OPNR \*\_s*' ..
+        '\d OPNR +\_s*' ..
+        '\d STORESCALAR $1\_s*' ..
+        'i += 1\_s*' ..
+        '\d\+ OPNRLOCAL $0 + 1\_s*' ..
+        'endwhile\_s*' ..
+        '\d\+ JUMP -> 2\_s*' ..
+        'if total > 100\_s*' ..
+        '12 LOADSCALAR $1\_s*' ..
+        '\d\+ COMPARENRJUMP > 100 -> 16\_s*' ..
+        'return total\_s*' ..
+        '\d\+ LOADSCALAR $1\_s*' ..
+        '\d\+ RETURN\_s*' ..
+        'else\_s*' ..
+        'total = 0\_s*' ..
+        '16 STORE 0 in $1\_s*' ..
+        'endif\_s*' ..
+        'while true\_s*' ..
+        'total += 2\_s*' ..
+        '17 OPNRLOCAL $1 + 2\_s*' ..
+        'if total > 5\_s*' ..
+        '\d\+ LOADSCALAR $1\_s*' ..
+        '\d\+ COMPARENRJUMP > 5 -> 17\_s*' ..
+        'break\_s*' ..
+        'endif\_s*' ..
+        'endwhile\_s*' ..
+        'return total\_s*' ..
+        '\d\+ LOADSCALAR $1\_s*' ..
+        '\d\+ RETURN',
+        instr)
+  assert_equal(135, Peephole(#{factor: 3}))
+  assert_equal(6, Peephole(#{factor: 1}))
+  assert_fails('call Peephole({})', 'E716:')
+enddef
+
 def Test_disassemble_compare_const()
   let cases = [
         ['"xx" == "yy"', false],
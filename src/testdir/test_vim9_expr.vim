@@ -854,6 +854,48 @@ def Test_expr_member()
   call CheckDefExecFailure(["let d: dict<number>", "d = g:list_empty"], 'E1029: Expected dict but got list')
 enddef
 
+def GetCachedVars(d: dict<any>): list<any>
+  return [g:cached, b:cached, d.member]
+enddef
+
+def Test_expr_cached_lookup()
+  g:cached = 1
+  b:cached = 2
+  let d = #{member: 3}
+  assert_equal([1, 2, 3], GetCachedVars(d))
+  assert_equal([1, 2, 3], GetCachedVars(d))
+
+  " change the value, the item stays the same
+  g:cached = 4
+  d['member'] = 5
+  assert_equal([4, 2, 5], GetCachedVars(d))
+
+  " remove and add again, the item is different
+  unlet g:cached
+  remove(d, 'member')
+  g:cached = 6
+  d['member'] = 7
+  assert_equal([6, 2, 7], GetCachedVars(d))
+
+  " add many items so that the hashtab is resized
+  for i in range(100)
+    d['x' .. i] = i
+  endfor
+  assert_equal([6, 2, 7], GetCachedVars(d))
+
+  " another dict and another buffer
+  assert_equal([6, 2, 8], GetCachedVars(#{member: 8}))
+  new
+  b:cached = 9
+  assert_equal([6, 9, 7], GetCachedVars(d))
+  bwipe!
+  assert_equal([6, 2, 7], GetCachedVars(d))
+
+  unlet g:cached
+  assert_fails('call GetCachedVars({})', 'E121:')
+  unlet b:cached
+enddef
+
 def Test_expr7_option()
   " option
   set ts=11
@@ -1195,6 +1195,25 @@ def Test_for_loop()
   assert_equal('0_1_3_', result)
 enddef
 
+def ForMixedList(): list<any>
+  let l: list<number> = g:mixed_list
+  let res = []
+  for nr in l
+    res->add(nr)
+  endfor
+  let first = l[0]
+  res->add(first)
+  return res
+enddef
+
+def Test_for_loop_member_type_not_checked()
+  " the number variable may end up containing a string
+  g:mixed_list = ['one', 2, 'three']
+  assert_equal(['one', 2, 'three', 'one'], ForMixedList())
+  assert_equal(['one', 2, 'three', 'one'], ForMixedList())
+  unlet g:mixed_list
+enddef
+
 def Test_for_loop_fails()
   CheckDefFailure(['for # in range(5)'], 'E690:')
   CheckDefFailure(['for i In range(5)'], 'E690:')
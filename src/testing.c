@@ -668,6 +668,16 @@ f_test_getvalue(typval_T *argvars, typval_T *rettv)
 
 	if (STRCMP(name, (char_u *)"need_fileinfo") == 0)
 	    rettv->vval.v_number = need_fileinfo;
+	else if (STRCMP(name, (char_u *)"term_frame_bytes") == 0)
+	    rettv->vval.v_number = term_frame_bytes;
+	else if (STRCMP(name, (char_u *)"term_frame_writes") == 0)
+	    rettv->vval.v_number = term_frame_writes;
+	else if (STRCMP(name, (char_u *)"memfile_hits") == 0)
+	    rettv->vval.v_number = curbuf->b_ml.ml_mfp == NULL ? 0
+					 : curbuf->b_ml.ml_mfp->mf_hit_count;
+	else if (STRCMP(name, (char_u *)"memfile_misses") == 0)
+	    rettv->vval.v_number = curbuf->b_ml.ml_mfp == NULL ? 0
+					: curbuf->b_ml.ml_mfp->mf_miss_count;
 	else
 	    semsg(_(e_invarg2), name);
     }
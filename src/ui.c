@@ -370,6 +370,14 @@ inchar_loop(
 	    wait_time = 100L;
 #endif
 
+#if defined(FEAT_SYN_HL) && defined(FEAT_RELTIME)
+	// While waiting use the time to parse syntax of lines that are not
+	// displayed.  When there is more to do only wait briefly, so that
+	// timers still work.
+	if (wtime < 0 && syn_idle_parse() && (wait_time < 0 || wait_time > 10L))
+	    wait_time = 10L;
+#endif
+
 	// Wait for a character to be typed or another event, such as the winch
 	// signal or an event on the monitored file descriptors.
 	did_call_wait_func = TRUE;
@@ -542,6 +550,9 @@ ui_delay(long msec, int ignoreinput)
         if (gui.in_use)
             gui_macvim_force_flush();
 #endif
+	// The screen must be up to date while waiting.
+	screen_flush_clear();
+	out_flush();
 	mch_delay(msec, ignoreinput);
     }
 }
@@ -2735,18 +2735,17 @@ u_undoredo(int undo)
 		}
 		break;
 	    }
-	    // delete backwards, it goes faster in most cases
 	    for (lnum = bot - 1, i = oldsize; --i >= 0; --lnum)
 	    {
 		// what can we do when we run out of memory?
 		if (u_save_line(&newarray[i], lnum) == FAIL)
 		    do_outofmem_msg((long_u)0);
-		// remember we deleted the last line in the buffer, and a
-		// dummy empty line will be inserted
-		if (curbuf->b_ml.ml_line_count == 1)
-		    empty_buffer = TRUE;
-		ml_delete(lnum, FALSE);
 	    }
+	    // remember we delete the last line in the buffer, and a
+	    // dummy empty line will be inserted
+	    if (curbuf->b_ml.ml_line_count == oldsize)
+		empty_buffer = TRUE;
+	    ml_delete_lines(bot - oldsize, oldsize, FALSE);
 	}
 	else
 	    newarray = NULL;
@@ -673,6 +673,11 @@ static char *(features[]) =
 	"-vartabs",
 #endif
 	"+vertsplit",
+#ifdef FEAT_VIM9_THREADED
+	"+vim9_threaded",
+#else
+	"-vim9_threaded",
+#endif
 	"+virtualedit",
 	"+visual",
 	"+visualextra",
@@ -21,11 +21,12 @@ typedef enum {
 
     // get and set variables
     ISN_LOAD,	    // push local variable isn_arg.number
+    ISN_LOADSCALAR, // push local scalar variable isn_arg.number
     ISN_LOADV,	    // push v: variable isn_arg.number
-    ISN_LOADG,	    // push g: variable isn_arg.string
-    ISN_LOADB,	    // push b: variable isn_arg.string
-    ISN_LOADW,	    // push w: variable isn_arg.string
-    ISN_LOADT,	    // push t: variable isn_arg.string
+    ISN_LOADG,	    // push g: variable isn_arg.varcache
+    ISN_LOADB,	    // push b: variable isn_arg.varcache
+    ISN_LOADW,	    // push w: variable isn_arg.varcache
+    ISN_LOADT,	    // push t: variable isn_arg.varcache
     ISN_LOADS,	    // push s: variable isn_arg.loadstore
     ISN_LOADOUTER,  // push variable from outer scope isn_arg.number
     ISN_LOADSCRIPT, // push script-local variable isn_arg.script.
@@ -34,6 +35,7 @@ typedef enum {
     ISN_LOADREG,    // push register isn_arg.number
 
     ISN_STORE,	    // pop into local variable isn_arg.number
+    ISN_STORESCALAR, // pop into local scalar variable isn_arg.number
     ISN_STOREV,	    // pop into v: variable isn_arg.number
     ISN_STOREG,	    // pop into global variable isn_arg.string
     ISN_STOREB,	    // pop into buffer-local variable isn_arg.string
@@ -113,7 +115,7 @@ typedef enum {
     ISN_CONCAT,
     ISN_INDEX,	    // [expr] list index
     ISN_MEMBER,	    // dict[member]
-    ISN_STRINGMEMBER, // dict.member using isn_arg.string
+    ISN_STRINGMEMBER, // dict.member using isn_arg.varcache
     ISN_2BOOL,	    // convert value to bool, invert if isn_arg.number != 0
     ISN_2STRING,    // convert value to string at isn_arg.number on stack
     ISN_NEGATENR,   // apply "-" to number
@@ -121,6 +123,17 @@ typedef enum {
     ISN_CHECKNR,    // check value can be used as a number
     ISN_CHECKTYPE,  // check value type is isn_arg.type.tc_type
 
+    // superinstructions, produced by the peephole optimizer
+    ISN_OPNRLOCAL,  // number operation on local variable with constant,
+		    // uses isn_arg.opconst
+    ISN_OPNRCONST,  // number operation on top of stack with constant,
+		    // uses isn_arg.opconst
+    ISN_COMPARENRJUMP, // compare numbers and jump if false,
+		    // uses isn_arg.opconst
+    ISN_COMPARESTRINGCONST, // compare string with isn_arg.cmpstr
+    ISN_LOADMEMBER, // push member of dict in local variable,
+		    // uses isn_arg.loadmember
+
     ISN_DROP	    // pop stack and discard value
 } isntype_T;
 
@@ -186,6 +199,37 @@ typedef struct {
     int		op_ic;	    // TRUE with '#', FALSE with '?', else MAYBE
 } opexpr_T;
 
+// arguments to ISN_OPNRLOCAL, ISN_OPNRCONST and ISN_COMPARENRJUMP
+typedef struct {
+    exptype_T	opc_type;	// operator
+    varnumber_T	opc_value;	// constant second argument
+    int		opc_const;	// ISN_COMPARENRJUMP: use "opc_value"
+    int		opc_idx;	// ISN_OPNRLOCAL: local variable index
+    int		opc_where;	// ISN_COMPARENRJUMP: position to jump to
+} opconst_T;
+
+// arguments to ISN_COMPARESTRINGCONST
+typedef struct {
+    exptype_T	cs_type;
+    int		cs_ic;		// TRUE with '#', FALSE with '?', else MAYBE
+    char_u	*cs_string;	// string to compare with, may be NULL
+} cmpstr_T;
+
+// arguments to ISN_LOADG, ISN_LOADB, ISN_LOADW, ISN_LOADT and
+// ISN_STRINGMEMBER: the name and the item it was found as, valid as long as
+// the "ht_changed" stamp of the hashtab it was found in is "vc_changed".
+typedef struct {
+    char_u	*vc_name;	// variable or member name
+    long_u	vc_changed;	// "ht_changed" when "vc_di" was found, or 0
+    dictitem_T	*vc_di;		// cached item
+} varcache_T;
+
+// arguments to ISN_LOADMEMBER
+typedef struct {
+    int		lm_idx;		// local variable index
+    varcache_T	lm_member;	// member name and cached item
+} loadmember_T;
+
 // arguments to ISN_CHECKTYPE
 typedef struct {
     vartype_T	ct_type;
@@ -234,6 +278,9 @@ typedef struct {
 struct isn_S {
     isntype_T	isn_type;
     int		isn_lnum;
+#ifdef FEAT_VIM9_THREADED
+    void	*isn_handler;	    // address of the code executing it
+#endif
     union {
 	char_u		    *string;
 	varnumber_T	    number;
@@ -260,6 +307,10 @@ struct isn_S {
 	script_T	    script;
 	unlet_T		    unlet;
 	funcref_T	    funcref;
+	opconst_T	    opconst;
+	cmpstr_T	    cmpstr;
+	loadmember_T	    loadmember;
+	varcache_T	    varcache;
     } isn_arg;
 };
 
@@ -277,6 +328,9 @@ struct dfunc_S {
 
     int		df_varcount;	    // number of local variables
     int		df_closure_count;   // number of closures created
+#ifdef FEAT_VIM9_THREADED
+    int		df_threaded;	    // isn_handler set in df_instr
+#endif
 };
 
 // Number of entries used by stack frame for a function call.
@@ -1053,6 +1053,18 @@ generate_PUSHFUNC(cctx_T *cctx, char_u *name, type_T *type)
     return OK;
 }
 
+/*
+ * Return TRUE if a value of type "type" never needs to be freed: a number,
+ * float, bool or special.  Such a local variable can be loaded and stored with
+ * ISN_LOADSCALAR and ISN_STORESCALAR.
+ */
+    static int
+type_is_scalar(type_T *type)
+{
+    return type->tt_type == VAR_NUMBER || type->tt_type == VAR_BOOL
+		|| type->tt_type == VAR_SPECIAL || type->tt_type == VAR_FLOAT;
+}
+
 /*
  * Generate an ISN_STORE instruction.
  */
@@ -1072,6 +1084,17 @@ generate_STORE(cctx_T *cctx, isntype_T isn_type, int idx, char_u *name)
     return OK;
 }
 
+/*
+ * Generate an ISN_STORE or ISN_STORESCALAR instruction for local variable
+ * "lvar".
+ */
+    static int
+generate_STORE_local(cctx_T *cctx, lvar_T *lvar)
+{
+    return generate_STORE(cctx, type_is_scalar(lvar->lv_type)
+			   ? ISN_STORESCALAR : ISN_STORE, lvar->lv_idx, NULL);
+}
+
 /*
  * Generate an ISN_STORENR instruction (short for ISN_PUSHNR + ISN_STORE)
  */
@@ -1120,9 +1143,18 @@ generate_LOAD(
     isn_T	*isn;
 
     RETURN_OK_IF_SKIP(cctx);
+    if (isn_type == ISN_LOAD && idx >= 0 && type_is_scalar(type))
+	isn_type = ISN_LOADSCALAR;
     if ((isn = generate_instr_type(cctx, isn_type, type)) == NULL)
 	return FAIL;
-    if (name != NULL)
+    if (isn_type == ISN_LOADG || isn_type == ISN_LOADB
+				|| isn_type == ISN_LOADW || isn_type == ISN_LOADT)
+    {
+	isn->isn_arg.varcache.vc_name = vim_strsave(name);
+	isn->isn_arg.varcache.vc_changed = 0;
+	isn->isn_arg.varcache.vc_di = NULL;
+    }
+    else if (name != NULL)
 	isn->isn_arg.string = vim_strsave(name);
     else
 	isn->isn_arg.number = idx;
@@ -1575,7 +1607,9 @@ generate_STRINGMEMBER(cctx_T *cctx, char_u *name, size_t len)
     RETURN_OK_IF_SKIP(cctx);
     if ((isn = generate_instr(cctx, ISN_STRINGMEMBER)) == NULL)
 	return FAIL;
-    isn->isn_arg.string = vim_strnsave(name, (int)len);
+    isn->isn_arg.varcache.vc_name = vim_strnsave(name, (int)len);
+    isn->isn_arg.varcache.vc_changed = 0;
+    isn->isn_arg.varcache.vc_di = NULL;
 
     // check for dict type
     type = ((type_T **)stack->ga_data)[stack->ga_len - 1];
@@ -4470,7 +4504,7 @@ compile_nested_function(exarg_T *eap, cctx_T *cctx)
 						    TRUE, ufunc->uf_func_type);
 
     if (generate_FUNCREF(cctx, ufunc->uf_dfunc_idx) == FAIL
-	    || generate_STORE(cctx, ISN_STORE, lvar->lv_idx, NULL) == FAIL)
+	    || generate_STORE_local(cctx, lvar) == FAIL)
 	return NULL;
 
     // TODO: warning for trailing text?
@@ -5246,7 +5280,7 @@ compile_assignment(char_u *arg, exarg_T *eap, cmdidx_T cmdidx, cctx_T *cctx)
 			generate_STORE(cctx, ISN_STOREOUTER, lvar->lv_idx,
 									 NULL);
 		    else
-			generate_STORE(cctx, ISN_STORE, lvar->lv_idx, NULL);
+			generate_STORE_local(cctx, lvar);
 		}
 		break;
 	}
@@ -5742,7 +5776,7 @@ compile_for(char_u *arg, cctx_T *cctx)
     scope->se_u.se_for.fs_top_label = instr->ga_len;
 
     generate_FOR(cctx, loop_lvar->lv_idx);
-    generate_STORE(cctx, ISN_STORE, var_lvar->lv_idx, NULL);
+    generate_STORE_local(cctx, var_lvar);
 
     return arg;
 }
@@ -6325,6 +6359,390 @@ add_def_function(ufunc_T *ufunc)
     return OK;
 }
 
+// Flags used by optimize_instructions() for each instruction.
+#define PEEP_TARGET	1	// a jump target or an entry point
+#define PEEP_REMOVED	2	// to be deleted
+
+/*
+ * Set PEEP_TARGET in "flags" for the instructions where execution may continue
+ * other than from the previous instruction.
+ */
+    static void
+peep_mark_targets(isn_T *isns, int count, ufunc_T *ufunc, char_u *flags)
+{
+    int idx;
+
+    flags[0] |= PEEP_TARGET;
+    if (ufunc->uf_def_arg_idx != NULL)
+	for (idx = 0; idx <= ufunc->uf_def_args.ga_len; ++idx)
+	    flags[ufunc->uf_def_arg_idx[idx]] |= PEEP_TARGET;
+
+    for (idx = 0; idx < count; ++idx)
+    {
+	isn_T *isn = isns + idx;
+
+	switch (isn->isn_type)
+	{
+	    case ISN_JUMP:
+		flags[isn->isn_arg.jump.jump_where] |= PEEP_TARGET;
+		break;
+	    case ISN_COMPARENRJUMP:
+		flags[isn->isn_arg.opconst.opc_where] |= PEEP_TARGET;
+		break;
+	    case ISN_FOR:
+		flags[isn->isn_arg.forloop.for_end] |= PEEP_TARGET;
+		break;
+	    case ISN_TRY:
+		flags[isn->isn_arg.try.try_catch] |= PEEP_TARGET;
+		flags[isn->isn_arg.try.try_finally] |= PEEP_TARGET;
+		break;
+	    default:
+		break;
+	}
+    }
+}
+
+/*
+ * Change instruction positions after instructions were removed.  "newidx"
+ * has the new position for each old position.
+ */
+    static void
+peep_adjust_positions(isn_T *isns, int count, ufunc_T *ufunc, int *newidx)
+{
+    int idx;
+
+    if (ufunc->uf_def_arg_idx != NULL)
+	for (idx = 0; idx <= ufunc->uf_def_args.ga_len; ++idx)
+	    ufunc->uf_def_arg_idx[idx] = newidx[ufunc->uf_def_arg_idx[idx]];
+
+    for (idx = 0; idx < count; ++idx)
+    {
+	isn_T *isn = isns + idx;
+
+	switch (isn->isn_type)
+	{
+	    case ISN_JUMP:
+		isn->isn_arg.jump.jump_where =
+					   newidx[isn->isn_arg.jump.jump_where];
+		break;
+	    case ISN_COMPARENRJUMP:
+		isn->isn_arg.opconst.opc_where =
+					newidx[isn->isn_arg.opconst.opc_where];
+		break;
+	    case ISN_FOR:
+		isn->isn_arg.forloop.for_end =
+					   newidx[isn->isn_arg.forloop.for_end];
+		break;
+	    case ISN_TRY:
+		isn->isn_arg.try.try_catch = newidx[isn->isn_arg.try.try_catch];
+		isn->isn_arg.try.try_finally =
+					  newidx[isn->isn_arg.try.try_finally];
+		break;
+	    default:
+		break;
+	}
+    }
+}
+
+/*
+ * Return the position where a jump to "where" ends up, following
+ * unconditional jumps.
+ */
+    static int
+peep_jump_dest(isn_T *isns, int count, int where)
+{
+    int n;
+
+    // limit the count, a loop without a condition jumps to itself
+    for (n = 0; n < count && where < count; ++n)
+    {
+	isn_T *isn = isns + where;
+
+	if (isn->isn_type != ISN_JUMP
+				|| isn->isn_arg.jump.jump_when != JUMP_ALWAYS)
+	    break;
+	where = isn->isn_arg.jump.jump_where;
+    }
+    return where;
+}
+
+/*
+ * Return TRUE if "arg1 type arg2" can be computed while compiling.  Division
+ * by zero and overflow are left for when executing.
+ */
+    static int
+peep_can_fold(exptype_T type, varnumber_T arg2)
+{
+    return !((type == EXPR_DIV || type == EXPR_REM)
+					       && (arg2 == 0 || arg2 == -1));
+}
+
+/*
+ * Try optimizing the instruction at "idx" with the instructions following
+ * it, up to the next jump target.  Instructions that are no longer needed get
+ * PEEP_REMOVED set in "flags".
+ * Returns TRUE when something was changed.
+ */
+    static int
+peep_instruction(isn_T *isns, int count, int idx, char_u *flags)
+{
+    isn_T	*isn = isns + idx;
+    isn_T	*next = isn + 1;
+    int		avail;
+    int		n;
+
+    // Number of following instructions that can be combined with this one.
+    for (avail = 0; avail < 3 && idx + avail + 1 < count
+			   && !(flags[idx + avail + 1] & PEEP_TARGET); ++avail)
+	;
+
+    switch (isn->isn_type)
+    {
+	case ISN_PUSHNR:
+	case ISN_PUSHBOOL:
+	    if (avail >= 1 && next->isn_type == ISN_JUMP
+			 && next->isn_arg.jump.jump_when == JUMP_IF_FALSE)
+	    {
+		// Condition is a constant: either never jump or always jump.
+		if (isn->isn_type == ISN_PUSHNR ? isn->isn_arg.number != 0
+					: isn->isn_arg.number == VVAL_TRUE)
+		    flags[idx] |= PEEP_REMOVED;
+		else
+		{
+		    isn->isn_type = ISN_JUMP;
+		    isn->isn_arg.jump = next->isn_arg.jump;
+		    isn->isn_arg.jump.jump_when = JUMP_ALWAYS;
+		}
+		flags[idx + 1] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+	    if (isn->isn_type == ISN_PUSHBOOL)
+		break;
+
+	    // "-123"
+	    if (avail >= 1 && next->isn_type == ISN_NEGATENR)
+	    {
+		isn->isn_arg.number = -isn->isn_arg.number;
+		flags[idx + 1] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+
+	    // "12 + 34" and "12 < 34"
+	    if (avail >= 2 && next->isn_type == ISN_PUSHNR
+		    && (next[1].isn_type == ISN_OPNR
+					   || next[1].isn_type == ISN_COMPARENR)
+		    && peep_can_fold(next[1].isn_arg.op.op_type,
+							 next->isn_arg.number))
+	    {
+		varnumber_T res = number_op(next[1].isn_arg.op.op_type,
+				   isn->isn_arg.number, next->isn_arg.number);
+
+		if (next[1].isn_type == ISN_COMPARENR)
+		{
+		    isn->isn_type = ISN_PUSHBOOL;
+		    res = res ? VVAL_TRUE : VVAL_FALSE;
+		}
+		isn->isn_arg.number = res;
+		flags[idx + 1] |= PEEP_REMOVED;
+		flags[idx + 2] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+
+	    // "while i < 10"
+	    if (avail >= 2 && next->isn_type == ISN_COMPARENR
+		    && next[1].isn_type == ISN_JUMP
+		    && next[1].isn_arg.jump.jump_when == JUMP_IF_FALSE)
+	    {
+		varnumber_T nr = isn->isn_arg.number;
+
+		isn->isn_type = ISN_COMPARENRJUMP;
+		CLEAR_FIELD(isn->isn_arg.opconst);
+		isn->isn_arg.opconst.opc_type = next->isn_arg.op.op_type;
+		isn->isn_arg.opconst.opc_value = nr;
+		isn->isn_arg.opconst.opc_const = TRUE;
+		isn->isn_arg.opconst.opc_where = next[1].isn_arg.jump.jump_where;
+		flags[idx + 1] |= PEEP_REMOVED;
+		flags[idx + 2] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+
+	    // "n * 2"
+	    if (avail >= 1 && next->isn_type == ISN_OPNR)
+	    {
+		varnumber_T nr = isn->isn_arg.number;
+
+		isn->isn_type = ISN_OPNRCONST;
+		CLEAR_FIELD(isn->isn_arg.opconst);
+		isn->isn_arg.opconst.opc_type = next->isn_arg.op.op_type;
+		isn->isn_arg.opconst.opc_value = nr;
+		flags[idx + 1] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+	    break;
+
+	case ISN_LOAD:
+	case ISN_LOADSCALAR:
+	    // "i += 1"
+	    if (avail >= 3 && next->isn_type == ISN_PUSHNR
+		    && next[1].isn_type == ISN_OPNR
+		    && (next[2].isn_type == ISN_STORE
+				     || next[2].isn_type == ISN_STORESCALAR)
+		    && next[2].isn_arg.number == isn->isn_arg.number)
+	    {
+		int lidx = isn->isn_arg.number;
+
+		isn->isn_type = ISN_OPNRLOCAL;
+		CLEAR_FIELD(isn->isn_arg.opconst);
+		isn->isn_arg.opconst.opc_type = next[1].isn_arg.op.op_type;
+		isn->isn_arg.opconst.opc_value = next->isn_arg.number;
+		isn->isn_arg.opconst.opc_idx = lidx;
+		for (n = 1; n <= 3; ++n)
+		    flags[idx + n] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+
+	    // "dict.member"
+	    if (avail >= 1 && next->isn_type == ISN_STRINGMEMBER)
+	    {
+		int lidx = isn->isn_arg.number;
+
+		isn->isn_type = ISN_LOADMEMBER;
+		isn->isn_arg.loadmember.lm_idx = lidx;
+		isn->isn_arg.loadmember.lm_member = next->isn_arg.varcache;
+		next->isn_arg.varcache.vc_name = NULL;
+		flags[idx + 1] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+	    break;
+
+	case ISN_PUSHS:
+	    // "name == 'text'"
+	    if (avail >= 1 && next->isn_type == ISN_COMPARESTRING)
+	    {
+		char_u *str = isn->isn_arg.string;
+
+		isn->isn_type = ISN_COMPARESTRINGCONST;
+		isn->isn_arg.cmpstr.cs_type = next->isn_arg.op.op_type;
+		isn->isn_arg.cmpstr.cs_ic = next->isn_arg.op.op_ic;
+		isn->isn_arg.cmpstr.cs_string = str;
+		flags[idx + 1] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+	    break;
+
+	case ISN_COMPARENR:
+	    // "while i < n"
+	    if (avail >= 1 && next->isn_type == ISN_JUMP
+			 && next->isn_arg.jump.jump_when == JUMP_IF_FALSE)
+	    {
+		exptype_T type = isn->isn_arg.op.op_type;
+
+		isn->isn_type = ISN_COMPARENRJUMP;
+		CLEAR_FIELD(isn->isn_arg.opconst);
+		isn->isn_arg.opconst.opc_type = type;
+		isn->isn_arg.opconst.opc_where = next->isn_arg.jump.jump_where;
+		flags[idx + 1] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+	    break;
+
+	case ISN_COMPARENRJUMP:
+	    n = peep_jump_dest(isns, count, isn->isn_arg.opconst.opc_where);
+	    if (n != isn->isn_arg.opconst.opc_where)
+	    {
+		isn->isn_arg.opconst.opc_where = n;
+		return TRUE;
+	    }
+	    break;
+
+	case ISN_JUMP:
+	    n = peep_jump_dest(isns, count, isn->isn_arg.jump.jump_where);
+	    if (n != isn->isn_arg.jump.jump_where)
+	    {
+		isn->isn_arg.jump.jump_where = n;
+		return TRUE;
+	    }
+	    if (isn->isn_arg.jump.jump_when != JUMP_ALWAYS)
+		break;
+	    if (n == idx + 1)
+	    {
+		// jump to the next instruction
+		flags[idx] |= PEEP_REMOVED;
+		return TRUE;
+	    }
+	    // FALLTHROUGH
+
+	case ISN_RETURN:
+	case ISN_THROW:
+	    // What follows can only be reached by a jump.
+	    for (n = idx + 1; n < count && !(flags[n] & PEEP_TARGET); ++n)
+		flags[n] |= PEEP_REMOVED;
+	    return n > idx + 1;
+
+	default:
+	    break;
+    }
+    return FALSE;
+}
+
+/*
+ * Peephole optimizer, used on the instructions of a function after all of
+ * them have been generated:
+ * - compute operations on constants
+ * - combine common sequences of instructions into one superinstruction,
+ *   this reduces the number of dispatches and typval copies when executing
+ * - drop jumps to the next instruction and code that can't be reached, let
+ *   a jump to an unconditional jump go to where that one goes
+ * Instructions are not combined when one of the later ones is a jump target.
+ * Dropped instructions are deleted and the positions in jumps, loops, try
+ * blocks and "uf_def_arg_idx" are adjusted.
+ */
+    static void
+optimize_instructions(garray_T *instr, ufunc_T *ufunc)
+{
+    char_u	*flags = alloc(instr->ga_len + 1);
+    int		*newidx = ALLOC_MULT(int, instr->ga_len + 1);
+    int		pass;
+    int		changed = TRUE;
+
+    // Each change may make another one possible, a few passes is enough.
+    for (pass = 0; changed && pass < 4 && flags != NULL && newidx != NULL;
+									++pass)
+    {
+	isn_T	*isns = (isn_T *)instr->ga_data;
+	int	count = instr->ga_len;
+	int	idx;
+	int	to;
+
+	changed = FALSE;
+	vim_memset(flags, 0, count + 1);
+	peep_mark_targets(isns, count, ufunc, flags);
+	for (idx = 0; idx < count; ++idx)
+	    if (!(flags[idx] & PEEP_REMOVED)
+				    && peep_instruction(isns, count, idx, flags))
+		changed = TRUE;
+	if (!changed)
+	    break;
+
+	// Delete the dropped instructions and move the others up.
+	to = 0;
+	for (idx = 0; idx < count; ++idx)
+	{
+	    newidx[idx] = to;
+	    if (flags[idx] & PEEP_REMOVED)
+		delete_instr(isns + idx);
+	    else
+		isns[to++] = isns[idx];
+	}
+	newidx[count] = to;
+	instr->ga_len = to;
+	peep_adjust_positions(isns, to, ufunc, newidx);
+    }
+
+    vim_free(flags);
+    vim_free(newidx);
+}
+
 /*
  * After ex_function() has collected all the function lines: parse and compile
  * the lines into instructions.
@@ -6759,12 +7177,17 @@ compile_def_function(ufunc_T *ufunc, int set_return_type, cctx_T *outer_cctx)
 	generate_instr(&cctx, ISN_RETURN);
     }
 
+    optimize_instructions(instr, ufunc);
+
     {
 	dfunc_T	*dfunc = ((dfunc_T *)def_functions.ga_data)
 							 + ufunc->uf_dfunc_idx;
 	dfunc->df_deleted = FALSE;
 	dfunc->df_instr = instr->ga_data;
 	dfunc->df_instr_count = instr->ga_len;
+#ifdef FEAT_VIM9_THREADED
+	dfunc->df_threaded = FALSE;
+#endif
 	dfunc->df_varcount = cctx.ctx_locals_count;
 	dfunc->df_closure_count = cctx.ctx_closure_count;
 	if (cctx.ctx_outer_used)
@@ -6869,12 +7292,7 @@ delete_instr(isn_T *isn)
     {
 	case ISN_EXEC:
 	case ISN_LOADENV:
-	case ISN_LOADG:
-	case ISN_LOADB:
-	case ISN_LOADW:
-	case ISN_LOADT:
 	case ISN_LOADOPT:
-	case ISN_STRINGMEMBER:
 	case ISN_PUSHEXC:
 	case ISN_PUSHS:
 	case ISN_STOREENV:
@@ -6886,6 +7304,14 @@ delete_instr(isn_T *isn)
 	    vim_free(isn->isn_arg.string);
 	    break;
 
+	case ISN_LOADG:
+	case ISN_LOADB:
+	case ISN_LOADW:
+	case ISN_LOADT:
+	case ISN_STRINGMEMBER:
+	    vim_free(isn->isn_arg.varcache.vc_name);
+	    break;
+
 	case ISN_LOADS:
 	case ISN_STORES:
 	    vim_free(isn->isn_arg.loadstore.ls_name);
@@ -6900,6 +7326,14 @@ delete_instr(isn_T *isn)
 	    vim_free(isn->isn_arg.storeopt.so_name);
 	    break;
 
+	case ISN_COMPARESTRINGCONST:
+	    vim_free(isn->isn_arg.cmpstr.cs_string);
+	    break;
+
+	case ISN_LOADMEMBER:
+	    vim_free(isn->isn_arg.loadmember.lm_member.vc_name);
+	    break;
+
 	case ISN_PUSHBLOB:   // push blob isn_arg.blob
 	    blob_unref(isn->isn_arg.blob);
 	    break;
@@ -6944,6 +7378,7 @@ delete_instr(isn_T *isn)
 	case ISN_COMPAREFUNC:
 	case ISN_COMPARELIST:
 	case ISN_COMPARENR:
+	case ISN_COMPARENRJUMP:
 	case ISN_COMPARESPECIAL:
 	case ISN_COMPARESTRING:
 	case ISN_CONCAT:
@@ -6961,6 +7396,7 @@ delete_instr(isn_T *isn)
 	case ISN_JUMP:
 	case ISN_LOAD:
 	case ISN_LOADOUTER:
+	case ISN_LOADSCALAR:
 	case ISN_LOADSCRIPT:
 	case ISN_LOADREG:
 	case ISN_LOADV:
@@ -6968,6 +7404,8 @@ delete_instr(isn_T *isn)
 	case ISN_NEWDICT:
 	case ISN_NEWLIST:
 	case ISN_OPNR:
+	case ISN_OPNRCONST:
+	case ISN_OPNRLOCAL:
 	case ISN_OPFLOAT:
 	case ISN_OPANY:
 	case ISN_PCALL:
@@ -6979,6 +7417,7 @@ delete_instr(isn_T *isn)
 	case ISN_RETURN:
 	case ISN_STORE:
 	case ISN_STOREOUTER:
+	case ISN_STORESCALAR:
 	case ISN_STOREV:
 	case ISN_STORENR:
 	case ISN_STOREREG:
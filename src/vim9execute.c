@@ -72,6 +72,59 @@ typedef struct {
 // Get pointer to item relative to the bottom of the stack, -1 is the last one.
 #define STACK_TV_BOT(idx) (((typval_T *)ectx->ec_stack.ga_data) + ectx->ec_stack.ga_len + idx)
 
+#ifdef FEAT_VIM9_THREADED
+// With direct threading the address of the code executing an instruction is
+// stored in the instruction by thread_instructions() and jumped to with a
+// computed goto.  CASE() adds the label for this next to the case of the
+// switch, which is still used when the instruction type has no label, then
+// "isn_handler" is NULL.
+# define CASE(name) case name: lbl_##name
+
+// Jump to the code executing instruction "iptr".
+# define GOTO_INSTR \
+	do { \
+	    if (iptr->isn_handler == NULL) \
+		goto lbl_switch; \
+	    goto *iptr->isn_handler; \
+	} while (0)
+
+// Continue with the next instruction without the checks at the start of the
+// loop.  Only for instructions that do not jump, throw or give an error
+// message without failing.
+# define NEXT_INSTR \
+	do { \
+	    iptr = &ectx.ec_instr[ectx.ec_iidx++]; \
+	    GOTO_INSTR; \
+	} while (0)
+
+// Address of the code executing each instruction type, set by
+// call_def_function().  NULL for types that only have a case in the switch.
+static void **isn_handlers = NULL;
+
+/*
+ * Store the address of the code executing each instruction of "dfunc" in
+ * the instruction.  Only done once, compiling clears "df_threaded".
+ */
+    static void
+thread_instructions(dfunc_T *dfunc)
+{
+    int idx;
+
+    if (dfunc->df_threaded)
+	return;
+    for (idx = 0; idx < dfunc->df_instr_count; ++idx)
+    {
+	isn_T *isn = dfunc->df_instr + idx;
+
+	isn->isn_handler = isn_handlers[isn->isn_type];
+    }
+    dfunc->df_threaded = TRUE;
+}
+#else
+# define CASE(name) case name
+# define NEXT_INSTR break
+#endif
+
 /*
  * Return the number of arguments, including optional arguments and any vararg.
  */
@@ -230,6 +283,9 @@ call_dfunc(int cdf_idx, int argcount_arg, ectx_T *ectx)
     // Set execution state to the start of the called function.
     ectx->ec_dfunc_idx = cdf_idx;
     ectx->ec_instr = dfunc->df_instr;
+#ifdef FEAT_VIM9_THREADED
+    thread_instructions(dfunc);
+#endif
     estack_push_ufunc(dfunc->df_ufunc, 1);
 
     // Decide where to start execution, handles optional arguments.
@@ -408,6 +464,9 @@ func_return(ectx_T *ectx)
     ectx->ec_frame_idx = STACK_TV(ectx->ec_frame_idx + 2)->vval.v_number;
     dfunc = ((dfunc_T *)def_functions.ga_data) + ectx->ec_dfunc_idx;
     ectx->ec_instr = dfunc->df_instr;
+#ifdef FEAT_VIM9_THREADED
+    thread_instructions(dfunc);
+#endif
 
     // Reset the stack to the position before the call, move the return value
     // to the top of the stack.
@@ -500,6 +559,9 @@ call_ufunc(ufunc_T *ufunc, int argcount, ectx_T *ectx, isn_T *iptr)
 	    iptr->isn_type = ISN_DCALL;
 	    iptr->isn_arg.dfunc.cdf_idx = ufunc->uf_dfunc_idx;
 	    iptr->isn_arg.dfunc.cdf_argcount = argcount;
+#ifdef FEAT_VIM9_THREADED
+	    iptr->isn_handler = isn_handlers[ISN_DCALL];
+#endif
 	}
 	return call_dfunc(ufunc->uf_dfunc_idx, argcount, ectx);
     }
@@ -635,6 +697,56 @@ call_eval_func(char_u *name, int argcount, ectx_T *ectx, isn_T *iptr)
     return OK;
 }
 
+/*
+ * Find variable or dict member "vc->vc_name" in hashtab "ht".  When "ht" did
+ * not change since the previous lookup the item cached in "vc" is used, that
+ * only takes comparing the "ht_changed" stamp.
+ * Returns NULL when not found.
+ */
+    static dictitem_T *
+find_var_cached(hashtab_T *ht, varcache_T *vc)
+{
+    dictitem_T	*di;
+
+    // A stamp is never zero after hash_init(), a zero-initialized hashtab is
+    // empty and "vc_di" is NULL before the first lookup.
+    if (vc->vc_changed == ht->ht_changed)
+	return vc->vc_di;
+    di = find_var_in_ht(ht, 0, vc->vc_name, TRUE);
+    if (di != NULL)
+    {
+	vc->vc_changed = ht->ht_changed;
+	vc->vc_di = di;
+    }
+    return di;
+}
+
+/*
+ * Compute "arg1 type arg2" for numbers, "type" is an arithmetic or compare
+ * operator.  For a compare operator the result is TRUE or FALSE.
+ * Also used for folding constants when compiling.
+ */
+    varnumber_T
+number_op(exptype_T type, varnumber_T arg1, varnumber_T arg2)
+{
+    switch (type)
+    {
+	case EXPR_MULT: return arg1 * arg2;
+	case EXPR_DIV: return arg1 / arg2;
+	case EXPR_REM: return arg1 % arg2;
+	case EXPR_SUB: return arg1 - arg2;
+	case EXPR_ADD: return arg1 + arg2;
+
+	case EXPR_EQUAL: return arg1 == arg2;
+	case EXPR_NEQUAL: return arg1 != arg2;
+	case EXPR_GREATER: return arg1 > arg2;
+	case EXPR_GEQUAL: return arg1 >= arg2;
+	case EXPR_SMALLER: return arg1 < arg2;
+	case EXPR_SEQUAL: return arg1 <= arg2;
+	default: return 0;
+    }
+}
+
 /*
  * Call a "def" function from old Vim script.
  * Return OK or FAIL.
@@ -657,6 +769,104 @@ call_def_function(
     int		save_sc_version = current_sctx.sc_version;
     int		breakcheck_count = 0;
     int		called_emsg_before = called_emsg;
+#ifdef FEAT_VIM9_THREADED
+    // Address of the code executing each instruction type.  A type missing
+    // here is executed with the switch.
+    static void *handlers[ISN_DROP + 1] = {
+	[ISN_EXEC] = &&lbl_ISN_EXEC,
+	[ISN_EXECCONCAT] = &&lbl_ISN_EXECCONCAT,
+	[ISN_ECHO] = &&lbl_ISN_ECHO,
+	[ISN_EXECUTE] = &&lbl_ISN_EXECUTE,
+	[ISN_ECHOMSG] = &&lbl_ISN_ECHOMSG,
+	[ISN_ECHOERR] = &&lbl_ISN_ECHOERR,
+	[ISN_LOAD] = &&lbl_ISN_LOAD,
+	[ISN_LOADSCALAR] = &&lbl_ISN_LOADSCALAR,
+	[ISN_LOADV] = &&lbl_ISN_LOADV,
+	[ISN_LOADG] = &&lbl_ISN_LOADG,
+	[ISN_LOADB] = &&lbl_ISN_LOADB,
+	[ISN_LOADW] = &&lbl_ISN_LOADW,
+	[ISN_LOADT] = &&lbl_ISN_LOADT,
+	[ISN_LOADS] = &&lbl_ISN_LOADS,
+	[ISN_LOADOUTER] = &&lbl_ISN_LOADOUTER,
+	[ISN_LOADSCRIPT] = &&lbl_ISN_LOADSCRIPT,
+	[ISN_LOADOPT] = &&lbl_ISN_LOADOPT,
+	[ISN_LOADENV] = &&lbl_ISN_LOADENV,
+	[ISN_LOADREG] = &&lbl_ISN_LOADREG,
+	[ISN_STORE] = &&lbl_ISN_STORE,
+	[ISN_STORESCALAR] = &&lbl_ISN_STORESCALAR,
+	[ISN_STOREV] = &&lbl_ISN_STOREV,
+	[ISN_STOREG] = &&lbl_ISN_STOREG,
+	[ISN_STOREB] = &&lbl_ISN_STOREB,
+	[ISN_STOREW] = &&lbl_ISN_STOREW,
+	[ISN_STORET] = &&lbl_ISN_STORET,
+	[ISN_STORES] = &&lbl_ISN_STORES,
+	[ISN_STOREOUTER] = &&lbl_ISN_STOREOUTER,
+	[ISN_STORESCRIPT] = &&lbl_ISN_STORESCRIPT,
+	[ISN_STOREOPT] = &&lbl_ISN_STOREOPT,
+	[ISN_STOREENV] = &&lbl_ISN_STOREENV,
+	[ISN_STOREREG] = &&lbl_ISN_STOREREG,
+	[ISN_STORENR] = &&lbl_ISN_STORENR,
+	[ISN_STORELIST] = &&lbl_ISN_STORELIST,
+	[ISN_STOREDICT] = &&lbl_ISN_STOREDICT,
+	[ISN_UNLET] = &&lbl_ISN_UNLET,
+	[ISN_UNLETENV] = &&lbl_ISN_UNLETENV,
+	[ISN_PUSHNR] = &&lbl_ISN_PUSHNR,
+	[ISN_PUSHBOOL] = &&lbl_ISN_PUSHBOOL,
+	[ISN_PUSHSPEC] = &&lbl_ISN_PUSHSPEC,
+	[ISN_PUSHF] = &&lbl_ISN_PUSHF,
+	[ISN_PUSHS] = &&lbl_ISN_PUSHS,
+	[ISN_PUSHBLOB] = &&lbl_ISN_PUSHBLOB,
+	[ISN_PUSHFUNC] = &&lbl_ISN_PUSHFUNC,
+	[ISN_PUSHCHANNEL] = &&lbl_ISN_PUSHCHANNEL,
+	[ISN_PUSHJOB] = &&lbl_ISN_PUSHJOB,
+	[ISN_NEWLIST] = &&lbl_ISN_NEWLIST,
+	[ISN_NEWDICT] = &&lbl_ISN_NEWDICT,
+	[ISN_BCALL] = &&lbl_ISN_BCALL,
+	[ISN_DCALL] = &&lbl_ISN_DCALL,
+	[ISN_UCALL] = &&lbl_ISN_UCALL,
+	[ISN_PCALL] = &&lbl_ISN_PCALL,
+	[ISN_PCALL_END] = &&lbl_ISN_PCALL_END,
+	[ISN_RETURN] = &&lbl_ISN_RETURN,
+	[ISN_FUNCREF] = &&lbl_ISN_FUNCREF,
+	[ISN_JUMP] = &&lbl_ISN_JUMP,
+	[ISN_FOR] = &&lbl_ISN_FOR,
+	[ISN_TRY] = &&lbl_ISN_TRY,
+	[ISN_THROW] = &&lbl_ISN_THROW,
+	[ISN_PUSHEXC] = &&lbl_ISN_PUSHEXC,
+	[ISN_CATCH] = &&lbl_ISN_CATCH,
+	[ISN_ENDTRY] = &&lbl_ISN_ENDTRY,
+	[ISN_ADDLIST] = &&lbl_ISN_ADDLIST,
+	[ISN_ADDBLOB] = &&lbl_ISN_ADDBLOB,
+	[ISN_OPNR] = &&lbl_ISN_OPNR,
+	[ISN_OPFLOAT] = &&lbl_ISN_OPFLOAT,
+	[ISN_OPANY] = &&lbl_ISN_OPANY,
+	[ISN_COMPAREBOOL] = &&lbl_ISN_COMPAREBOOL,
+	[ISN_COMPARESPECIAL] = &&lbl_ISN_COMPARESPECIAL,
+	[ISN_COMPARENR] = &&lbl_ISN_COMPARENR,
+	[ISN_COMPAREFLOAT] = &&lbl_ISN_COMPAREFLOAT,
+	[ISN_COMPARESTRING] = &&lbl_ISN_COMPARESTRING,
+	[ISN_COMPAREBLOB] = &&lbl_ISN_COMPAREBLOB,
+	[ISN_COMPARELIST] = &&lbl_ISN_COMPARELIST,
+	[ISN_COMPAREDICT] = &&lbl_ISN_COMPAREDICT,
+	[ISN_COMPAREFUNC] = &&lbl_ISN_COMPAREFUNC,
+	[ISN_COMPAREANY] = &&lbl_ISN_COMPAREANY,
+	[ISN_CONCAT] = &&lbl_ISN_CONCAT,
+	[ISN_INDEX] = &&lbl_ISN_INDEX,
+	[ISN_MEMBER] = &&lbl_ISN_MEMBER,
+	[ISN_STRINGMEMBER] = &&lbl_ISN_STRINGMEMBER,
+	[ISN_2BOOL] = &&lbl_ISN_2BOOL,
+	[ISN_2STRING] = &&lbl_ISN_2STRING,
+	[ISN_NEGATENR] = &&lbl_ISN_NEGATENR,
+	[ISN_CHECKNR] = &&lbl_ISN_CHECKNR,
+	[ISN_CHECKTYPE] = &&lbl_ISN_CHECKTYPE,
+	[ISN_OPNRLOCAL] = &&lbl_ISN_OPNRLOCAL,
+	[ISN_OPNRCONST] = &&lbl_ISN_OPNRCONST,
+	[ISN_COMPARENRJUMP] = &&lbl_ISN_COMPARENRJUMP,
+	[ISN_COMPARESTRINGCONST] = &&lbl_ISN_COMPARESTRINGCONST,
+	[ISN_LOADMEMBER] = &&lbl_ISN_LOADMEMBER,
+	[ISN_DROP] = &&lbl_ISN_DROP,
+    };
+#endif
 
 // Get pointer to item in the stack.
 #define STACK_TV(idx) (((typval_T *)ectx.ec_stack.ga_data) + idx)
@@ -671,6 +881,10 @@ call_def_function(
 // Like STACK_TV_VAR but use the outer scope
 #define STACK_OUT_TV_VAR(idx) (((typval_T *)ectx.ec_outer_stack->ga_data) + ectx.ec_outer_frame + STACK_FRAME_SIZE + idx)
 
+#ifdef FEAT_VIM9_THREADED
+    isn_handlers = handlers;
+#endif
+
     if (ufunc->uf_dfunc_idx == UF_NOT_COMPILED
 	    || (ufunc->uf_dfunc_idx == UF_TO_BE_COMPILED
 			  && compile_def_function(ufunc, FALSE, NULL) == FAIL))
@@ -760,6 +974,9 @@ call_def_function(
 	ectx.ec_stack.ga_len += count;
 
 	ectx.ec_instr = dfunc->df_instr;
+#ifdef FEAT_VIM9_THREADED
+	thread_instructions(dfunc);
+#endif
     }
 
     // Commands behave like vim9script.
@@ -836,16 +1053,20 @@ call_def_function(
 	}
 
 	iptr = &ectx.ec_instr[ectx.ec_iidx++];
+#ifdef FEAT_VIM9_THREADED
+	GOTO_INSTR;
+lbl_switch:
+#endif
 	switch (iptr->isn_type)
 	{
 	    // execute Ex command line
-	    case ISN_EXEC:
+	    CASE(ISN_EXEC):
 		SOURCING_LNUM = iptr->isn_lnum;
 		do_cmdline_cmd(iptr->isn_arg.string);
 		break;
 
 	    // execute Ex command from pieces on the stack
-	    case ISN_EXECCONCAT:
+	    CASE(ISN_EXECCONCAT):
 		{
 		    int	    count = iptr->isn_arg.number;
 		    size_t  len = 0;
@@ -885,7 +1106,7 @@ call_def_function(
 		break;
 
 	    // execute :echo {string} ...
-	    case ISN_ECHO:
+	    CASE(ISN_ECHO):
 		{
 		    int count = iptr->isn_arg.echo.echo_count;
 		    int	atstart = TRUE;
@@ -907,9 +1128,9 @@ call_def_function(
 	    // :execute {string} ...
 	    // :echomsg {string} ...
 	    // :echoerr {string} ...
-	    case ISN_EXECUTE:
-	    case ISN_ECHOMSG:
-	    case ISN_ECHOERR:
+	    CASE(ISN_EXECUTE):
+	    CASE(ISN_ECHOMSG):
+	    CASE(ISN_ECHOERR):
 		{
 		    int		count = iptr->isn_arg.number;
 		    garray_T	ga;
@@ -968,24 +1189,42 @@ call_def_function(
 		break;
 
 	    // load local variable or argument
-	    case ISN_LOAD:
+	    CASE(ISN_LOAD):
 		if (GA_GROW(&ectx.ec_stack, 1) == FAIL)
 		    goto failed;
 		copy_tv(STACK_TV_VAR(iptr->isn_arg.number), STACK_TV_BOT(0));
 		++ectx.ec_stack.ga_len;
-		break;
+		NEXT_INSTR;
+
+	    // load local variable with a number, float, bool or special type:
+	    // nothing to reference, copy the value as-is.  The type of a list
+	    // member is not checked at runtime, thus fall back to copy_tv() if
+	    // the value turns out to be something else.
+	    CASE(ISN_LOADSCALAR):
+		if (GA_GROW(&ectx.ec_stack, 1) == FAIL)
+		    goto failed;
+		tv = STACK_TV_VAR(iptr->isn_arg.number);
+		if (tv->v_type <= VAR_FLOAT)
+		{
+		    *STACK_TV_BOT(0) = *tv;
+		    STACK_TV_BOT(0)->v_lock = 0;
+		}
+		else
+		    copy_tv(tv, STACK_TV_BOT(0));
+		++ectx.ec_stack.ga_len;
+		NEXT_INSTR;
 
 	    // load variable or argument from outer scope
-	    case ISN_LOADOUTER:
+	    CASE(ISN_LOADOUTER):
 		if (GA_GROW(&ectx.ec_stack, 1) == FAIL)
 		    goto failed;
 		copy_tv(STACK_OUT_TV_VAR(iptr->isn_arg.number),
 							      STACK_TV_BOT(0));
 		++ectx.ec_stack.ga_len;
-		break;
+		NEXT_INSTR;
 
 	    // load v: variable
-	    case ISN_LOADV:
+	    CASE(ISN_LOADV):
 		if (GA_GROW(&ectx.ec_stack, 1) == FAIL)
 		    goto failed;
 		copy_tv(get_vim_var_tv(iptr->isn_arg.number), STACK_TV_BOT(0));
@@ -993,7 +1232,7 @@ call_def_function(
 		break;
 
 	    // load s: variable in Vim9 script
-	    case ISN_LOADSCRIPT:
+	    CASE(ISN_LOADSCRIPT):
 		{
 		    scriptitem_T *si =
 				  SCRIPT_ITEM(iptr->isn_arg.script.script_sid);
@@ -1009,7 +1248,7 @@ call_def_function(
 		break;
 
 	    // load s: variable in old script
-	    case ISN_LOADS:
+	    CASE(ISN_LOADS):
 		{
 		    hashtab_T	*ht = &SCRIPT_VARS(
 					       iptr->isn_arg.loadstore.ls_sid);
@@ -1032,10 +1271,10 @@ call_def_function(
 		break;
 
 	    // load g:/b:/w:/t: variable
-	    case ISN_LOADG:
-	    case ISN_LOADB:
-	    case ISN_LOADW:
-	    case ISN_LOADT:
+	    CASE(ISN_LOADG):
+	    CASE(ISN_LOADB):
+	    CASE(ISN_LOADW):
+	    CASE(ISN_LOADT):
 		{
 		    dictitem_T *di = NULL;
 		    hashtab_T *ht = NULL;
@@ -1061,12 +1300,12 @@ call_def_function(
 			default:  // Cannot reach here
 			    goto failed;
 		    }
-		    di = find_var_in_ht(ht, 0, iptr->isn_arg.string, TRUE);
+		    di = find_var_cached(ht, &iptr->isn_arg.varcache);
 
 		    if (di == NULL)
 		    {
 			semsg(_("E121: Undefined variable: %c:%s"),
-					     namespace, iptr->isn_arg.string);
+				      namespace, iptr->isn_arg.varcache.vc_name);
 			goto failed;
 		    }
 		    else
@@ -1080,7 +1319,7 @@ call_def_function(
 		break;
 
 	    // load &option
-	    case ISN_LOADOPT:
+	    CASE(ISN_LOADOPT):
 		{
 		    typval_T	optval;
 		    char_u	*name = iptr->isn_arg.string;
@@ -1097,7 +1336,7 @@ call_def_function(
 		break;
 
 	    // load $ENV
-	    case ISN_LOADENV:
+	    CASE(ISN_LOADENV):
 		{
 		    typval_T	optval;
 		    char_u	*name = iptr->isn_arg.string;
@@ -1112,7 +1351,7 @@ call_def_function(
 		break;
 
 	    // load @register
-	    case ISN_LOADREG:
+	    CASE(ISN_LOADREG):
 		if (GA_GROW(&ectx.ec_stack, 1) == FAIL)
 		    goto failed;
 		tv = STACK_TV_BOT(0);
@@ -1123,23 +1362,33 @@ call_def_function(
 		break;
 
 	    // store local variable
-	    case ISN_STORE:
+	    CASE(ISN_STORE):
 		--ectx.ec_stack.ga_len;
 		tv = STACK_TV_VAR(iptr->isn_arg.number);
 		clear_tv(tv);
 		*tv = *STACK_TV_BOT(0);
-		break;
+		NEXT_INSTR;
+
+	    // store local variable with a number, float, bool or special type:
+	    // the old value normally doesn't need to be freed
+	    CASE(ISN_STORESCALAR):
+		--ectx.ec_stack.ga_len;
+		tv = STACK_TV_VAR(iptr->isn_arg.number);
+		if (tv->v_type > VAR_FLOAT)
+		    clear_tv(tv);
+		*tv = *STACK_TV_BOT(0);
+		NEXT_INSTR;
 
 	    // store variable or argument in outer scope
-	    case ISN_STOREOUTER:
+	    CASE(ISN_STOREOUTER):
 		--ectx.ec_stack.ga_len;
 		tv = STACK_OUT_TV_VAR(iptr->isn_arg.number);
 		clear_tv(tv);
 		*tv = *STACK_TV_BOT(0);
-		break;
+		NEXT_INSTR;
 
 	    // store s: variable in old script
-	    case ISN_STORES:
+	    CASE(ISN_STORES):
 		{
 		    hashtab_T	*ht = &SCRIPT_VARS(
 					       iptr->isn_arg.loadstore.ls_sid);
@@ -1158,7 +1407,7 @@ call_def_function(
 		break;
 
 	    // store script-local variable in Vim9 script
-	    case ISN_STORESCRIPT:
+	    CASE(ISN_STORESCRIPT):
 		{
 		    scriptitem_T *si = SCRIPT_ITEM(
 					      iptr->isn_arg.script.script_sid);
@@ -1172,7 +1421,7 @@ call_def_function(
 		break;
 
 	    // store option
-	    case ISN_STOREOPT:
+	    CASE(ISN_STOREOPT):
 		{
 		    long	n = 0;
 		    char_u	*s = NULL;
@@ -1201,7 +1450,7 @@ call_def_function(
 		break;
 
 	    // store $ENV
-	    case ISN_STOREENV:
+	    CASE(ISN_STOREENV):
 		--ectx.ec_stack.ga_len;
 		tv = STACK_TV_BOT(0);
 		vim_setenv_ext(iptr->isn_arg.string, tv_get_string(tv));
@@ -1209,7 +1458,7 @@ call_def_function(
 		break;
 
 	    // store @r
-	    case ISN_STOREREG:
+	    CASE(ISN_STOREREG):
 		{
 		    int	reg = iptr->isn_arg.number;
 
@@ -1222,7 +1471,7 @@ call_def_function(
 		break;
 
 	    // store v: variable
-	    case ISN_STOREV:
+	    CASE(ISN_STOREV):
 		--ectx.ec_stack.ga_len;
 		if (set_vim_var_tv(iptr->isn_arg.number, STACK_TV_BOT(0))
 								       == FAIL)
@@ -1230,10 +1479,10 @@ call_def_function(
 		break;
 
 	    // store g:/b:/w:/t: variable
-	    case ISN_STOREG:
-	    case ISN_STOREB:
-	    case ISN_STOREW:
-	    case ISN_STORET:
+	    CASE(ISN_STOREG):
+	    CASE(ISN_STOREB):
+	    CASE(ISN_STOREW):
+	    CASE(ISN_STORET):
 		{
 		    dictitem_T *di;
 		    hashtab_T *ht;
@@ -1268,15 +1517,15 @@ call_def_function(
 		break;
 
 	    // store number in local variable
-	    case ISN_STORENR:
+	    CASE(ISN_STORENR):
 		tv = STACK_TV_VAR(iptr->isn_arg.storenr.stnr_idx);
 		clear_tv(tv);
 		tv->v_type = VAR_NUMBER;
 		tv->vval.v_number = iptr->isn_arg.storenr.stnr_val;
-		break;
+		NEXT_INSTR;
 
 	    // store value in list variable
-	    case ISN_STORELIST:
+	    CASE(ISN_STORELIST):
 		{
 		    typval_T	*tv_idx = STACK_TV_BOT(-2);
 		    varnumber_T	lidx = tv_idx->vval.v_number;
@@ -1314,7 +1563,7 @@ call_def_function(
 		break;
 
 	    // store value in dict variable
-	    case ISN_STOREDICT:
+	    CASE(ISN_STOREDICT):
 		{
 		    typval_T	*tv_key = STACK_TV_BOT(-2);
 		    char_u	*key = tv_key->vval.v_string;
@@ -1348,15 +1597,15 @@ call_def_function(
 		break;
 
 	    // push constant
-	    case ISN_PUSHNR:
-	    case ISN_PUSHBOOL:
-	    case ISN_PUSHSPEC:
-	    case ISN_PUSHF:
-	    case ISN_PUSHS:
-	    case ISN_PUSHBLOB:
-	    case ISN_PUSHFUNC:
-	    case ISN_PUSHCHANNEL:
-	    case ISN_PUSHJOB:
+	    CASE(ISN_PUSHNR):
+	    CASE(ISN_PUSHBOOL):
+	    CASE(ISN_PUSHSPEC):
+	    CASE(ISN_PUSHF):
+	    CASE(ISN_PUSHS):
+	    CASE(ISN_PUSHBLOB):
+	    CASE(ISN_PUSHFUNC):
+	    CASE(ISN_PUSHCHANNEL):
+	    CASE(ISN_PUSHJOB):
 		if (GA_GROW(&ectx.ec_stack, 1) == FAIL)
 		    goto failed;
 		tv = STACK_TV_BOT(0);
@@ -1414,26 +1663,26 @@ call_def_function(
 				iptr->isn_arg.string == NULL
 					? (char_u *)"" : iptr->isn_arg.string);
 		}
-		break;
+		NEXT_INSTR;
 
-	    case ISN_UNLET:
+	    CASE(ISN_UNLET):
 		if (do_unlet(iptr->isn_arg.unlet.ul_name,
 				       iptr->isn_arg.unlet.ul_forceit) == FAIL)
 		    goto failed;
 		break;
-	    case ISN_UNLETENV:
+	    CASE(ISN_UNLETENV):
 		vim_unsetenv(iptr->isn_arg.unlet.ul_name);
 		break;
 
 	    // create a list from items on the stack; uses a single allocation
 	    // for the list header and the items
-	    case ISN_NEWLIST:
+	    CASE(ISN_NEWLIST):
 		if (exe_newlist(iptr->isn_arg.number, &ectx) == FAIL)
 		    goto failed;
 		break;
 
 	    // create a dict from items on the stack
-	    case ISN_NEWDICT:
+	    CASE(ISN_NEWDICT):
 		{
 		    int	    count = iptr->isn_arg.number;
 		    dict_T  *dict = dict_alloc();
@@ -1469,7 +1718,7 @@ call_def_function(
 		break;
 
 	    // call a :def function
-	    case ISN_DCALL:
+	    CASE(ISN_DCALL):
 		if (call_dfunc(iptr->isn_arg.dfunc.cdf_idx,
 			      iptr->isn_arg.dfunc.cdf_argcount,
 			      &ectx) == FAIL)
@@ -1477,7 +1726,7 @@ call_def_function(
 		break;
 
 	    // call a builtin function
-	    case ISN_BCALL:
+	    CASE(ISN_BCALL):
 		SOURCING_LNUM = iptr->isn_lnum;
 		if (call_bfunc(iptr->isn_arg.bfunc.cbf_idx,
 			      iptr->isn_arg.bfunc.cbf_argcount,
@@ -1486,7 +1735,7 @@ call_def_function(
 		break;
 
 	    // call a funcref or partial
-	    case ISN_PCALL:
+	    CASE(ISN_PCALL):
 		{
 		    cpfunc_T	*pfunc = &iptr->isn_arg.pfunc;
 		    int		r;
@@ -1513,7 +1762,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_PCALL_END:
+	    CASE(ISN_PCALL_END):
 		// PCALL finished, arguments have been consumed and replaced by
 		// the return value.  Now clear the funcref from the stack,
 		// and move the return value in its place.
@@ -1523,7 +1772,7 @@ call_def_function(
 		break;
 
 	    // call a user defined function or funcref/partial
-	    case ISN_UCALL:
+	    CASE(ISN_UCALL):
 		{
 		    cufunc_T	*cufunc = &iptr->isn_arg.ufunc;
 
@@ -1535,7 +1784,7 @@ call_def_function(
 		break;
 
 	    // return from a :def function call
-	    case ISN_RETURN:
+	    CASE(ISN_RETURN):
 		{
 		    garray_T	*trystack = &ectx.ec_trystack;
 		    trycmd_T    *trycmd = NULL;
@@ -1569,7 +1818,7 @@ call_def_function(
 		break;
 
 	    // push a function reference to a compiled function
-	    case ISN_FUNCREF:
+	    CASE(ISN_FUNCREF):
 		{
 		    partial_T   *pt = NULL;
 		    dfunc_T	*pt_dfunc;
@@ -1623,7 +1872,7 @@ call_def_function(
 		break;
 
 	    // jump if a condition is met
-	    case ISN_JUMP:
+	    CASE(ISN_JUMP):
 		{
 		    jumpwhen_T	when = iptr->isn_arg.jump.jump_when;
 		    int		jump = TRUE;
@@ -1648,7 +1897,7 @@ call_def_function(
 		break;
 
 	    // top of a for loop
-	    case ISN_FOR:
+	    CASE(ISN_FOR):
 		{
 		    list_T	*list = STACK_TV_BOT(-1)->vval.v_list;
 		    typval_T	*idxtv =
@@ -1682,7 +1931,7 @@ call_def_function(
 		break;
 
 	    // start of ":try" block
-	    case ISN_TRY:
+	    CASE(ISN_TRY):
 		{
 		    trycmd_T    *trycmd = NULL;
 
@@ -1699,7 +1948,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_PUSHEXC:
+	    CASE(ISN_PUSHEXC):
 		if (current_exception == NULL)
 		{
 		    iemsg("Evaluating catch while current_exception is NULL");
@@ -1714,7 +1963,7 @@ call_def_function(
 					   (char_u *)current_exception->value);
 		break;
 
-	    case ISN_CATCH:
+	    CASE(ISN_CATCH):
 		{
 		    garray_T	*trystack = &ectx.ec_trystack;
 
@@ -1730,7 +1979,7 @@ call_def_function(
 		break;
 
 	    // end of ":try" block
-	    case ISN_ENDTRY:
+	    CASE(ISN_ENDTRY):
 		{
 		    garray_T	*trystack = &ectx.ec_trystack;
 
@@ -1768,7 +2017,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_THROW:
+	    CASE(ISN_THROW):
 		--ectx.ec_stack.ga_len;
 		tv = STACK_TV_BOT(0);
 		if (throw_exception(tv->vval.v_string, ET_USER, NULL) == FAIL)
@@ -1780,8 +2029,8 @@ call_def_function(
 		break;
 
 	    // compare with special values
-	    case ISN_COMPAREBOOL:
-	    case ISN_COMPARESPECIAL:
+	    CASE(ISN_COMPAREBOOL):
+	    CASE(ISN_COMPARESPECIAL):
 		{
 		    typval_T	*tv1 = STACK_TV_BOT(-2);
 		    typval_T	*tv2 = STACK_TV_BOT(-1);
@@ -1800,34 +2049,16 @@ call_def_function(
 		    tv1->v_type = VAR_BOOL;
 		    tv1->vval.v_number = res ? VVAL_TRUE : VVAL_FALSE;
 		}
-		break;
+		NEXT_INSTR;
 
 	    // Operation with two number arguments
-	    case ISN_OPNR:
-	    case ISN_COMPARENR:
+	    CASE(ISN_OPNR):
+	    CASE(ISN_COMPARENR):
 		{
 		    typval_T	*tv1 = STACK_TV_BOT(-2);
 		    typval_T	*tv2 = STACK_TV_BOT(-1);
-		    varnumber_T arg1 = tv1->vval.v_number;
-		    varnumber_T arg2 = tv2->vval.v_number;
-		    varnumber_T res;
-
-		    switch (iptr->isn_arg.op.op_type)
-		    {
-			case EXPR_MULT: res = arg1 * arg2; break;
-			case EXPR_DIV: res = arg1 / arg2; break;
-			case EXPR_REM: res = arg1 % arg2; break;
-			case EXPR_SUB: res = arg1 - arg2; break;
-			case EXPR_ADD: res = arg1 + arg2; break;
-
-			case EXPR_EQUAL: res = arg1 == arg2; break;
-			case EXPR_NEQUAL: res = arg1 != arg2; break;
-			case EXPR_GREATER: res = arg1 > arg2; break;
-			case EXPR_GEQUAL: res = arg1 >= arg2; break;
-			case EXPR_SMALLER: res = arg1 < arg2; break;
-			case EXPR_SEQUAL: res = arg1 <= arg2; break;
-			default: res = 0; break;
-		    }
+		    varnumber_T res = number_op(iptr->isn_arg.op.op_type,
+				       tv1->vval.v_number, tv2->vval.v_number);
 
 		    --ectx.ec_stack.ga_len;
 		    if (iptr->isn_type == ISN_COMPARENR)
@@ -1838,11 +2069,63 @@ call_def_function(
 		    else
 			tv1->vval.v_number = res;
 		}
+		NEXT_INSTR;
+
+	    // Operation on a local number variable with a constant: "i += 1"
+	    CASE(ISN_OPNRLOCAL):
+		tv = STACK_TV_VAR(iptr->isn_arg.opconst.opc_idx);
+		tv->vval.v_number = number_op(iptr->isn_arg.opconst.opc_type,
+			      tv->vval.v_number, iptr->isn_arg.opconst.opc_value);
+		NEXT_INSTR;
+
+	    // Operation on a number with a constant
+	    CASE(ISN_OPNRCONST):
+		tv = STACK_TV_BOT(-1);
+		tv->vval.v_number = number_op(iptr->isn_arg.opconst.opc_type,
+			      tv->vval.v_number, iptr->isn_arg.opconst.opc_value);
+		NEXT_INSTR;
+
+	    // Compare two numbers, or a number with a constant, and jump if
+	    // the result is false.
+	    CASE(ISN_COMPARENRJUMP):
+		{
+		    opconst_T	*opconst = &iptr->isn_arg.opconst;
+		    varnumber_T	arg2;
+
+		    if (opconst->opc_const)
+			arg2 = opconst->opc_value;
+		    else
+		    {
+			arg2 = STACK_TV_BOT(-1)->vval.v_number;
+			--ectx.ec_stack.ga_len;
+		    }
+		    --ectx.ec_stack.ga_len;
+		    if (!number_op(opconst->opc_type,
+					 STACK_TV_BOT(0)->vval.v_number, arg2))
+			ectx.ec_iidx = opconst->opc_where;
+		}
+		break;
+
+	    // Compare a string with a constant, the constant is not copied
+	    CASE(ISN_COMPARESTRINGCONST):
+		{
+		    typval_T	*tv1 = STACK_TV_BOT(-1);
+		    typval_T	tv2;
+
+		    tv2.v_type = VAR_STRING;
+		    tv2.v_lock = 0;
+		    tv2.vval.v_string = iptr->isn_arg.cmpstr.cs_string;
+		    typval_compare(tv1, &tv2, iptr->isn_arg.cmpstr.cs_type,
+						     iptr->isn_arg.cmpstr.cs_ic);
+		    tv1->v_type = VAR_BOOL;
+		    tv1->vval.v_number = tv1->vval.v_number
+						      ? VVAL_TRUE : VVAL_FALSE;
+		}
 		break;
 
 	    // Computation with two float arguments
-	    case ISN_OPFLOAT:
-	    case ISN_COMPAREFLOAT:
+	    CASE(ISN_OPFLOAT):
+	    CASE(ISN_COMPAREFLOAT):
 #ifdef FEAT_FLOAT
 		{
 		    typval_T	*tv1 = STACK_TV_BOT(-2);
@@ -1877,9 +2160,9 @@ call_def_function(
 			tv1->vval.v_float = res;
 		}
 #endif
-		break;
+		NEXT_INSTR;
 
-	    case ISN_COMPARELIST:
+	    CASE(ISN_COMPARELIST):
 		{
 		    typval_T	*tv1 = STACK_TV_BOT(-2);
 		    typval_T	*tv2 = STACK_TV_BOT(-1);
@@ -1906,7 +2189,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_COMPAREBLOB:
+	    CASE(ISN_COMPAREBLOB):
 		{
 		    typval_T	*tv1 = STACK_TV_BOT(-2);
 		    typval_T	*tv2 = STACK_TV_BOT(-1);
@@ -1931,10 +2214,10 @@ call_def_function(
 		break;
 
 		// TODO: handle separately
-	    case ISN_COMPARESTRING:
-	    case ISN_COMPAREDICT:
-	    case ISN_COMPAREFUNC:
-	    case ISN_COMPAREANY:
+	    CASE(ISN_COMPARESTRING):
+	    CASE(ISN_COMPAREDICT):
+	    CASE(ISN_COMPAREFUNC):
+	    CASE(ISN_COMPAREANY):
 		{
 		    typval_T	*tv1 = STACK_TV_BOT(-2);
 		    typval_T	*tv2 = STACK_TV_BOT(-1);
@@ -1950,8 +2233,8 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_ADDLIST:
-	    case ISN_ADDBLOB:
+	    CASE(ISN_ADDLIST):
+	    CASE(ISN_ADDBLOB):
 		{
 		    typval_T *tv1 = STACK_TV_BOT(-2);
 		    typval_T *tv2 = STACK_TV_BOT(-1);
@@ -1966,7 +2249,7 @@ call_def_function(
 		break;
 
 	    // Computation with two arguments of unknown type
-	    case ISN_OPANY:
+	    CASE(ISN_OPANY):
 		{
 		    typval_T	*tv1 = STACK_TV_BOT(-2);
 		    typval_T	*tv2 = STACK_TV_BOT(-1);
@@ -2066,7 +2349,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_CONCAT:
+	    CASE(ISN_CONCAT):
 		{
 		    char_u *str1 = STACK_TV_BOT(-2)->vval.v_string;
 		    char_u *str2 = STACK_TV_BOT(-1)->vval.v_string;
@@ -2080,7 +2363,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_INDEX:
+	    CASE(ISN_INDEX):
 		{
 		    list_T	*list;
 		    varnumber_T	n;
@@ -2114,7 +2397,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_MEMBER:
+	    CASE(ISN_MEMBER):
 		{
 		    dict_T	*dict;
 		    char_u	*key;
@@ -2139,10 +2422,10 @@ call_def_function(
 		    clear_tv(STACK_TV_BOT(-1));
 		    copy_tv(&di->di_tv, STACK_TV_BOT(-1));
 		}
-		break;
+		NEXT_INSTR;
 
 	    // dict member with string key
-	    case ISN_STRINGMEMBER:
+	    CASE(ISN_STRINGMEMBER):
 		{
 		    dict_T	*dict;
 		    dictitem_T	*di;
@@ -2155,18 +2438,44 @@ call_def_function(
 		    }
 		    dict = tv->vval.v_dict;
 
-		    if ((di = dict_find(dict, iptr->isn_arg.string, -1))
-								       == NULL)
+		    if ((di = find_var_cached(&dict->dv_hashtab,
+					       &iptr->isn_arg.varcache)) == NULL)
 		    {
-			semsg(_(e_dictkey), iptr->isn_arg.string);
+			semsg(_(e_dictkey), iptr->isn_arg.varcache.vc_name);
 			goto failed;
 		    }
 		    clear_tv(tv);
 		    copy_tv(&di->di_tv, tv);
 		}
-		break;
+		NEXT_INSTR;
+
+	    // dict member with string key of a local variable
+	    CASE(ISN_LOADMEMBER):
+		{
+		    dictitem_T	*di;
+
+		    // grow the stack first, it may move the local variable
+		    if (GA_GROW(&ectx.ec_stack, 1) == FAIL)
+			goto failed;
+		    tv = STACK_TV_VAR(iptr->isn_arg.loadmember.lm_idx);
+		    if (tv->v_type != VAR_DICT || tv->vval.v_dict == NULL)
+		    {
+			emsg(_(e_dictreq));
+			goto failed;
+		    }
+		    if ((di = find_var_cached(&tv->vval.v_dict->dv_hashtab,
+				 &iptr->isn_arg.loadmember.lm_member)) == NULL)
+		    {
+			semsg(_(e_dictkey),
+				    iptr->isn_arg.loadmember.lm_member.vc_name);
+			goto failed;
+		    }
+		    copy_tv(&di->di_tv, STACK_TV_BOT(0));
+		    ++ectx.ec_stack.ga_len;
+		}
+		NEXT_INSTR;
 
-	    case ISN_NEGATENR:
+	    CASE(ISN_NEGATENR):
 		tv = STACK_TV_BOT(-1);
 		if (tv->v_type != VAR_NUMBER
 #ifdef FEAT_FLOAT
@@ -2183,9 +2492,9 @@ call_def_function(
 		else
 #endif
 		    tv->vval.v_number = -tv->vval.v_number;
-		break;
+		NEXT_INSTR;
 
-	    case ISN_CHECKNR:
+	    CASE(ISN_CHECKNR):
 		{
 		    int		error = FALSE;
 
@@ -2198,7 +2507,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_CHECKTYPE:
+	    CASE(ISN_CHECKTYPE):
 		{
 		    checktype_T *ct = &iptr->isn_arg.type;
 
@@ -2218,7 +2527,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_2BOOL:
+	    CASE(ISN_2BOOL):
 		{
 		    int n;
 
@@ -2232,7 +2541,7 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_2STRING:
+	    CASE(ISN_2STRING):
 		{
 		    char_u *str;
 
@@ -2247,10 +2556,10 @@ call_def_function(
 		}
 		break;
 
-	    case ISN_DROP:
+	    CASE(ISN_DROP):
 		--ectx.ec_stack.ga_len;
 		clear_tv(STACK_TV_BOT(0));
-		break;
+		NEXT_INSTR;
 	}
     }
 
@@ -2277,6 +2586,33 @@ failed_early:
     return ret;
 }
 
+/*
+ * Return the text of operator "type" for ":disassemble".
+ */
+    static char *
+exptype_name(exptype_T type)
+{
+    switch (type)
+    {
+	case EXPR_MULT: return "*";
+	case EXPR_DIV: return "/";
+	case EXPR_REM: return "%";
+	case EXPR_SUB: return "-";
+	case EXPR_ADD: return "+";
+	case EXPR_EQUAL: return "==";
+	case EXPR_NEQUAL: return "!=";
+	case EXPR_GREATER: return ">";
+	case EXPR_GEQUAL: return ">=";
+	case EXPR_SMALLER: return "<";
+	case EXPR_SEQUAL: return "<=";
+	case EXPR_MATCH: return "=~";
+	case EXPR_IS: return "is";
+	case EXPR_ISNOT: return "isnot";
+	case EXPR_NOMATCH: return "!~";
+	default: return "???";
+    }
+}
+
 /*
  * ":dissassemble".
  * We don't really need this at runtime, but we do have tests that require it,
@@ -2382,8 +2718,10 @@ ex_disassemble(exarg_T *eap)
 		break;
 	    case ISN_LOAD:
 	    case ISN_LOADOUTER:
+	    case ISN_LOADSCALAR:
 		{
-		    char *add = iptr->isn_type == ISN_LOAD ? "" : "OUTER";
+		    char *add = iptr->isn_type == ISN_LOAD ? ""
+			    : iptr->isn_type == ISN_LOADOUTER ? "OUTER" : "SCALAR";
 
 		    if (iptr->isn_arg.number < 0)
 			smsg("%4d LOAD%s arg[%lld]", current, add,
@@ -2419,16 +2757,20 @@ ex_disassemble(exarg_T *eap)
 		}
 		break;
 	    case ISN_LOADG:
-		smsg("%4d LOADG g:%s", current, iptr->isn_arg.string);
+		smsg("%4d LOADG g:%s", current,
+					       iptr->isn_arg.varcache.vc_name);
 		break;
 	    case ISN_LOADB:
-		smsg("%4d LOADB b:%s", current, iptr->isn_arg.string);
+		smsg("%4d LOADB b:%s", current,
+					       iptr->isn_arg.varcache.vc_name);
 		break;
 	    case ISN_LOADW:
-		smsg("%4d LOADW w:%s", current, iptr->isn_arg.string);
+		smsg("%4d LOADW w:%s", current,
+					       iptr->isn_arg.varcache.vc_name);
 		break;
 	    case ISN_LOADT:
-		smsg("%4d LOADT t:%s", current, iptr->isn_arg.string);
+		smsg("%4d LOADT t:%s", current,
+					       iptr->isn_arg.varcache.vc_name);
 		break;
 	    case ISN_LOADOPT:
 		smsg("%4d LOADOPT %s", current, iptr->isn_arg.string);
@@ -2442,8 +2784,10 @@ ex_disassemble(exarg_T *eap)
 
 	    case ISN_STORE:
 	    case ISN_STOREOUTER:
+	    case ISN_STORESCALAR:
 		{
-		    char *add = iptr->isn_type == ISN_STORE ? "" : "OUTER";
+		    char *add = iptr->isn_type == ISN_STORE ? ""
+			  : iptr->isn_type == ISN_STOREOUTER ? "OUTER" : "SCALAR";
 
 		if (iptr->isn_arg.number < 0)
 		    smsg("%4d STORE%s arg[%lld]", current, add,
@@ -2791,9 +3135,60 @@ ex_disassemble(exarg_T *eap)
 	    case ISN_INDEX: smsg("%4d INDEX", current); break;
 	    case ISN_MEMBER: smsg("%4d MEMBER", current); break;
 	    case ISN_STRINGMEMBER: smsg("%4d MEMBER %s", current,
-						  iptr->isn_arg.string); break;
+				      iptr->isn_arg.varcache.vc_name); break;
 	    case ISN_NEGATENR: smsg("%4d NEGATENR", current); break;
 
+	    // superinstructions
+	    case ISN_OPNRLOCAL:
+		smsg("%4d OPNRLOCAL $%d %s %lld", current,
+			iptr->isn_arg.opconst.opc_idx,
+			exptype_name(iptr->isn_arg.opconst.opc_type),
+			(long long)iptr->isn_arg.opconst.opc_value);
+		break;
+	    case ISN_OPNRCONST:
+		smsg("%4d OPNRCONST %s %lld", current,
+			exptype_name(iptr->isn_arg.opconst.opc_type),
+			(long long)iptr->isn_arg.opconst.opc_value);
+		break;
+	    case ISN_COMPARENRJUMP:
+		{
+		    opconst_T *opconst = &iptr->isn_arg.opconst;
+
+		    if (opconst->opc_const)
+			smsg("%4d COMPARENRJUMP %s %lld -> %d", current,
+				exptype_name(opconst->opc_type),
+				(long long)opconst->opc_value,
+				opconst->opc_where);
+		    else
+			smsg("%4d COMPARENRJUMP %s -> %d", current,
+				exptype_name(opconst->opc_type),
+				opconst->opc_where);
+		}
+		break;
+	    case ISN_COMPARESTRINGCONST:
+		{
+		    cmpstr_T *cmpstr = &iptr->isn_arg.cmpstr;
+
+		    smsg("%4d COMPARESTRINGCONST %s%s \"%s\"", current,
+			    exptype_name(cmpstr->cs_type),
+			    cmpstr->cs_ic == TRUE ? "?" : "",
+			    cmpstr->cs_string == NULL
+					     ? "" : (char *)cmpstr->cs_string);
+		}
+		break;
+	    case ISN_LOADMEMBER:
+		{
+		    loadmember_T *lm = &iptr->isn_arg.loadmember;
+
+		    if (lm->lm_idx < 0)
+			smsg("%4d LOADMEMBER arg[%d].%s", current,
+			     lm->lm_idx + STACK_FRAME_SIZE, lm->lm_member.vc_name);
+		    else
+			smsg("%4d LOADMEMBER $%d.%s", current,
+					      lm->lm_idx, lm->lm_member.vc_name);
+		}
+		break;
+
 	    case ISN_CHECKNR: smsg("%4d CHECKNR", current); break;
 	    case ISN_CHECKTYPE: smsg("%4d CHECKTYPE %s stack[%d]", current,
 				      vartype_name(iptr->isn_arg.type.ct_type),